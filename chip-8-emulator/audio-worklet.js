@@ -0,0 +1,47 @@
+// plays the samples the page posts from the core each frame. Frames and audio callbacks don't line
+// up, so chunks queue here; running dry plays silence, and a queue grown past MAX_LATENCY (after a
+// hitch on the page) is trimmed from the front so the sound never lags the picture.
+const MAX_LATENCY = 0.1; // seconds
+
+class Chip8AudioProcessor extends AudioWorkletProcessor {
+  constructor() {
+    super();
+    this.chunks = [];
+    this.offset = 0; // samples already played from chunks[0]
+    this.queued = 0; // samples waiting, across all chunks
+    this.port.onmessage = (event) => {
+      this.chunks.push(event.data);
+      this.queued += event.data.length;
+      const limit = Math.ceil(MAX_LATENCY * sampleRate);
+      while (this.queued > limit && this.chunks.length > 1) {
+        this.queued -= this.chunks[0].length - this.offset;
+        this.chunks.shift();
+        this.offset = 0;
+      }
+    };
+  }
+
+  process(inputs, outputs) {
+    const output = outputs[0][0];
+    let written = 0;
+    while (written < output.length && this.chunks.length > 0) {
+      const chunk = this.chunks[0];
+      const count = Math.min(output.length - written, chunk.length - this.offset);
+      output.set(chunk.subarray(this.offset, this.offset + count), written);
+      written += count;
+      this.offset += count;
+      this.queued -= count;
+      if (this.offset === chunk.length) {
+        this.chunks.shift();
+        this.offset = 0;
+      }
+    }
+    output.fill(0, written);
+    for (let channel = 1; channel < outputs[0].length; channel++) {
+      outputs[0][channel].set(output);
+    }
+    return true;
+  }
+}
+
+registerProcessor("chip8-audio", Chip8AudioProcessor);
@@ -0,0 +1,98 @@
+// compares web builds for deployment: what a cold start has to download (the JS glue and the wasm,
+// raw and compressed the way a server would send them) and how long the browser engine then takes
+// to compile and instantiate the module. Each timing runs in a fresh node process, so nothing is
+// cached from the run before, and the median of RUNS is reported.
+//
+//   node build-report.js chip8-fast.js chip8-small.js ...   (make report builds and runs these)
+const { execFileSync } = require("child_process");
+const fs = require("fs");
+const zlib = require("zlib");
+
+const RUNS = 7;
+
+// child side: time one compile and instantiation of a wasm file, print them as JSON
+async function measure(wasmPath) {
+  const bytes = fs.readFileSync(wasmPath);
+  const start = process.hrtime.bigint();
+  const module = await WebAssembly.compile(bytes);
+  const compiled = process.hrtime.bigint();
+  // no emscripten glue: every import is a stand-in, enough to instantiate but never called
+  const imports = {};
+  for (const { module: from, name, kind } of WebAssembly.Module.imports(module)) {
+    imports[from] = imports[from] || {};
+    if (kind === "function") {
+      imports[from][name] = () => 0;
+    } else if (kind === "memory") {
+      imports[from][name] = new WebAssembly.Memory({ initial: 256, maximum: 65536, shared: true });
+    } else if (kind === "table") {
+      imports[from][name] = new WebAssembly.Table({ initial: 0, element: "anyfunc" });
+    } else {
+      imports[from][name] = new WebAssembly.Global({ value: "i32", mutable: true }, 0);
+    }
+  }
+  let instantiated = null;
+  try {
+    await WebAssembly.instantiate(module, imports);
+    instantiated = process.hrtime.bigint();
+  } catch (error) {
+    // imports this script can't stand in for, e.g. a table of a fixed size; compile time still counts
+  }
+  const ms = (from, to) => Number(to - from) / 1e6;
+  console.log(JSON.stringify({ compile: ms(start, compiled), instantiate: instantiated ? ms(compiled, instantiated) : null }));
+}
+
+function median(values) {
+  const sorted = values.filter((value) => value !== null).sort((a, b) => a - b);
+  return sorted.length ? sorted[Math.floor(sorted.length / 2)] : null;
+}
+
+function kilobytes(bytes) {
+  return (bytes / 1024).toFixed(1) + " KB";
+}
+
+function milliseconds(value) {
+  return value === null ? "n/a" : value.toFixed(2) + " ms";
+}
+
+function report(scripts) {
+  const columns = ["build", "js", "wasm", "gzip", "brotli", "compile", "instantiate"];
+  const rows = [];
+  for (const script of scripts) {
+    const wasmPath = script.replace(/\.js$/, ".wasm");
+    if (!fs.existsSync(script) || !fs.existsSync(wasmPath)) {
+      console.error(`build-report: ${script} or ${wasmPath} is missing, build it first`);
+      process.exitCode = 1;
+      continue;
+    }
+    const js = fs.readFileSync(script);
+    const wasm = fs.readFileSync(wasmPath);
+    const gzip = zlib.gzipSync(js, { level: 9 }).length + zlib.gzipSync(wasm, { level: 9 }).length;
+    const brotli = zlib.brotliCompressSync(js).length + zlib.brotliCompressSync(wasm).length;
+    const timings = [];
+    for (let run = 0; run < RUNS; run++) {
+      timings.push(JSON.parse(execFileSync(process.execPath, [__filename, "--measure", wasmPath], { encoding: "utf8" })));
+    }
+    rows.push([
+      script,
+      kilobytes(js.length),
+      kilobytes(wasm.length),
+      kilobytes(gzip),
+      kilobytes(brotli),
+      milliseconds(median(timings.map((timing) => timing.compile))),
+      milliseconds(median(timings.map((timing) => timing.instantiate))),
+    ]);
+  }
+  const widths = columns.map((column, i) => Math.max(column.length, ...rows.map((row) => row[i].length)));
+  const line = (cells) => cells.map((cell, i) => (i === 0 ? cell.padEnd(widths[i]) : cell.padStart(widths[i]))).join("  ");
+  console.log(line(columns));
+  rows.forEach((row) => console.log(line(row)));
+}
+
+if (process.argv[2] === "--measure") {
+  measure(process.argv[3]);
+} else if (process.argv.length > 2) {
+  report(process.argv.slice(2));
+} else {
+  console.error("usage: node build-report.js <build.js>...");
+  process.exitCode = 2;
+}
@@ -0,0 +1,65 @@
+#ifndef ANALYZE_H
+#define ANALYZE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "decode.h"
+#include "quirks.h"
+
+// what the analysis found each byte of memory to be used for, as bits
+enum ByteUse : uint8_t {
+    USE_CODE = 1 << 0,    // part of an instruction some path reaches
+    USE_READ = 1 << 1,    // read through I: sprites, FX65 and 5XY3 loads, F002 patterns
+    USE_WRITTEN = 1 << 2, // written through I by FX33, FX55 or 5XY2
+};
+
+// something worth a second look, found at address
+enum NoteKind : uint8_t {
+    NOTE_COMPUTED_JUMP, // BNNN: the target depends on a register, only a jump table at the base is followed
+    NOTE_CODE_STORE,    // a store through a known I that writes over reachable code
+    NOTE_UNKNOWN_STORE, // a store through an I the analysis couldn't follow, which may hit code
+    NOTE_INVALID,       // an opcode no profile knows is reachable, the interpreter steps over it and so does the walk
+    NOTE_MACHINE_CODE,  // 0NNN, which this interpreter steps over
+    NOTE_OUTSIDE_ROM,   // control reaches an address the ROM doesn't load anything at
+};
+
+struct AnalysisNote {
+    uint16_t address; // of the instruction
+    NoteKind kind;
+    OpKind op;
+    uint32_t target;  // stores: first byte written, computed jumps: the base, others: the target
+    uint16_t length;  // stores: bytes written, computed jumps: jump table entries followed
+};
+
+// straight-line code, entered only at start and left only after its last instruction
+struct CodeBlock {
+    uint16_t start;
+    uint16_t end; // just past the last instruction
+    std::vector<uint16_t> successors; // where control goes next, a call's return site included
+    bool inLoop;  // between the target and the source of a backward jump
+};
+
+// a static walk of a ROM from 0x200 through every jump, call, return and skip, decoded with
+// the interpreter's own decoder. I is followed from ANNN (and F000 NNNN) through straight-line
+// code and across jumps, so the sprites drawn, the bytes loaded and stored are known wherever it
+// is. Anything that depends on a register, BNNN's target or I after FX1E, is given up on and
+// noted instead of guessed at.
+struct RomAnalysis {
+    QuirkProfile profile;
+    size_t romSize;
+    std::vector<uint8_t> use;          // ByteUse bits per address, quirkMemorySize(profile) of them
+    std::vector<CodeBlock> blocks;     // ordered by start
+    std::vector<AnalysisNote> notes;   // ordered by address
+    size_t countBytes(uint8_t bits) const; // addresses with any of bits set
+    // block starts worth translating before the ROM runs, the ones inside loops first. Hand them to
+    // Chip8::precompile after loading the ROM.
+    std::vector<uint16_t> precompileHints() const;
+};
+
+RomAnalysis analyzeROM(const uint8_t* data, size_t size, QuirkProfile profile);
+const char* noteKindName(NoteKind kind); // e.g. "code_store"
+std::string formatAnalysis(const RomAnalysis& analysis, const std::string& name); // one line of JSON
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef AUDIO_H
+#define AUDIO_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class Chip8;
+
+// a bounded queue between exactly one producing and one consuming thread. Neither side ever
+// waits or takes a lock: each owns one index and only reads the other's.
+template <typename T>
+class SpscRing {
+    public:
+        explicit SpscRing(size_t capacity) // rounded up to a power of two
+        {
+            size_t size = 1;
+            while (size < capacity)
+            {
+                size <<= 1;
+            }
+            slots.resize(size);
+            mask = size - 1;
+        }
+
+        // producer only: stores as many of items as fit, returns how many
+        size_t push(const T* items, size_t count)
+        {
+            size_t end = tail.load(std::memory_order_relaxed);
+            size_t room = slots.size() - (end - head.load(std::memory_order_acquire));
+            count = count < room ? count : room;
+            for (size_t i = 0; i < count; i++)
+            {
+                slots[(end + i) & mask] = items[i];
+            }
+            tail.store(end + count, std::memory_order_release);
+            return count;
+        }
+
+        // consumer only: takes up to count items, returns how many
+        size_t pop(T* items, size_t count)
+        {
+            size_t start = head.load(std::memory_order_relaxed);
+            size_t available = tail.load(std::memory_order_acquire) - start;
+            count = count < available ? count : available;
+            for (size_t i = 0; i < count; i++)
+            {
+                items[i] = slots[(start + i) & mask];
+            }
+            head.store(start + count, std::memory_order_release);
+            return count;
+        }
+
+        size_t capacity() const { return slots.size(); }
+        size_t size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+
+    private:
+        std::vector<T> slots;
+        size_t mask;
+        alignas(64) std::atomic<size_t> head{0}; // next slot to pop, only the consumer writes it
+        alignas(64) std::atomic<size_t> tail{0}; // next slot to push, only the producer writes it
+};
+
+// turns a chip's sound into 16-bit mono samples, in step with emulated rather than wall clock
+// time: every emulated second is exactly sampleRate samples, wherever the samples end up.
+//
+// The tone sounds while the sound timer is above zero. XO-CHIP plays its 128-bit audio pattern at
+// 4000 * 2^((pitch - 64) / 48) bits per second; other profiles play a square wave through the same
+// path, at 500 Hz. attach() has the chip report every change as it happens, so a tone starts and
+// stops on the sample the instruction ran on, not at the next host frame.
+//
+// The emulating thread produces, one consumer (an audio callback, a file writer) reads. Producing
+// never waits: samples that don't fit because the consumer has fallen behind are dropped and counted.
+class AudioSynth {
+    public:
+        explicit AudioSynth(uint32_t sampleRate = 48000, size_t bufferSamples = 16384);
+        void setSampleRate(uint32_t hz); // producer side, e.g. to match the output device
+        uint32_t getSampleRate() const { return sampleRate; }
+        void attach(Chip8& chip8); // follow chip8's sound changes from now on
+        void update(const Chip8& chip8); // producer: render up to chip8's current emulated time
+        size_t read(int16_t* out, size_t count); // consumer: up to count samples, returns how many
+        size_t getBuffered() const { return ring.size(); }
+        uint64_t getDropped() const { return dropped.load(std::memory_order_relaxed); }
+
+    private:
+        void renderTo(const Chip8& chip8, uint64_t cycle); // the samples up to cycle, then the chip's new settings
+        void latch(const Chip8& chip8); // take the chip's sound settings for the samples that follow
+        void render(uint64_t count);
+
+        SpscRing<int16_t> ring;
+        uint32_t sampleRate;
+        uint64_t lastCycle = 0; // emulated time rendered up to
+        uint64_t cycleFraction = 0; // part of a sample left over, in 1/clockSpeed samples
+        bool sounding = false;
+        std::array<uint8_t, 16> pattern{};
+        uint8_t pitch = 0; // the pitch step was computed for
+        uint64_t step = 0; // pattern bits per sample, 32.32 fixed point
+        uint64_t position = 0; // in the pattern, 32.32 fixed point bits, wraps at 128
+        std::array<int16_t, 256> chunk; // samples on their way into the ring
+        std::atomic<uint64_t> dropped{0};
+};
+
+#endif
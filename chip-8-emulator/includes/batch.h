@@ -0,0 +1,53 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "movie.h"
+#include "rom.h"
+
+// one independent instance to run: a ROM, the input to feed it and how long to run it for
+struct BatchJob {
+    std::string name;                             // free text, copied into the result
+    std::shared_ptr<const RomImage> rom;          // shared, many jobs usually run the same ROM
+    std::vector<KeyEvent> keys;                   // sorted by cycle
+    uint64_t cycles = 0;                          // budget, in instructions
+    uint32_t clockSpeed = 700;
+    uint64_t seed = 1;                            // for CXNN, same seed and script give the same run
+    QuirkProfile quirks = QUIRKS_DEFAULT;
+};
+
+enum HaltReason : uint8_t {
+    HALT_BUDGET,    // ran every cycle it was given
+    HALT_SPIN,      // reached a jump to itself, nothing can change any more
+    HALT_KEY_WAIT,  // blocked in FX0A with no key presses left in its script
+    HALT_BAD_ROM,   // the ROM was missing or too large to load
+};
+
+const char* haltReasonName(HaltReason reason); // e.g. "spin"
+
+struct BatchResult {
+    uint64_t framebufferHash = 0; // Chip8::getDisplayHash when it halted
+    uint64_t cycles = 0;          // cycles run before halting
+    HaltReason halt = HALT_BUDGET;
+};
+
+// runs many Chip8 instances across a pool of threads. Every job is split into time slices; a worker
+// keeps running its own job slice after slice while idle workers steal jobs it hasn't started,
+// so uneven jobs still keep every thread busy and only about one instance per thread is alive. Once
+// there is nothing left to steal, idle workers sleep until the last job halts.
+class BatchRunner {
+    public:
+        explicit BatchRunner(unsigned threads = 0); // 0 = one per hardware thread
+        unsigned getThreadCount() const { return threadCount; }
+        void setSliceCycles(uint32_t cycles) { sliceCycles = cycles; } // work done between scheduling points
+        std::vector<BatchResult> run(const std::vector<BatchJob>& jobs); // results in job order
+
+    private:
+        unsigned threadCount;
+        uint32_t sliceCycles = 100000;
+};
+
+#endif
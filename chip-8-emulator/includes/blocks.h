@@ -0,0 +1,56 @@
+#ifndef BLOCKS_H
+#define BLOCKS_H
+
+#include <cstdint>
+#include <vector>
+#include "decode.h"
+
+// a straight-line run of instructions, translated once and then executed without fetching
+// each instruction by PC or checking for stops between them
+struct Block {
+    uint16_t start;  // address of the first instruction
+    uint16_t end;    // address just past the last instruction
+    uint16_t length; // number of instructions
+    uint32_t first;  // index of the first instruction in the shared op pool
+    bool idle;       // the block is a single jump to itself
+    bool timed;      // the first instruction reads or sets a timer
+};
+
+// true for instructions a block has to end on: anything that changes control flow, draws,
+// waits for a key or stores to memory (the store may overwrite the block itself)
+bool endsBlock(OpKind kind);
+
+// true for instructions after which execution doesn't simply go on with the next one: jumps, calls,
+// returns, skips and 00FD, and F000 NNNN, which is four bytes long
+bool changesFlow(OpKind kind);
+
+// true for instructions that read or set the delay or sound timer. These only ever start a block,
+// so the timer ticks that fall inside a block can be applied after it instead of mid-way.
+bool readsTimers(OpKind kind);
+
+// translated blocks of one Chip8, keyed by start address. Empty and allocation free until enabled.
+class BlockCache {
+    public:
+        static constexpr uint16_t MAX_LENGTH = 64; // longest block translated, longer runs are split
+
+        void setEnabled(bool on);
+        bool isEnabled() const { return enabled; }
+        const Block* find(uint16_t address) const // block starting at address, nullptr if not translated yet
+        {
+            uint16_t index = startAt[address & 0x0FFF];
+            return index == 0 ? nullptr : &blocks[index - 1];
+        }
+        const Block& add(uint16_t start, const DecodedOp* ops, uint16_t length, bool idle, bool timed);
+        const DecodedOp* ops(const Block& block) const { return pool.data() + block.first; }
+        void invalidate(uint16_t address); // drop every block containing the byte at address
+        void clear();
+
+    private:
+        bool enabled = false;
+        std::vector<Block> blocks;
+        std::vector<DecodedOp> pool;   // instructions of every block, back to back
+        std::vector<uint16_t> startAt; // per address: index + 1 of the block starting there, 0 if none
+        std::vector<uint8_t> covered;  // per address: number of blocks containing that byte
+};
+
+#endif
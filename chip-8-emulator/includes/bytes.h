@@ -0,0 +1,79 @@
+#ifndef BYTES_H
+#define BYTES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// helpers for the binary formats (save states, rewind deltas, movies): fixed-size integers are
+// little-endian, counts that are usually small are LEB128 varints
+
+inline void putLE(std::vector<uint8_t>& out, uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+    {
+        out.push_back(value >> (8 * i));
+    }
+}
+
+inline void putVarint(std::vector<uint8_t>& out, uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.push_back((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    out.push_back(value);
+}
+
+// reads back what the put functions wrote. Reading past the end returns zeros and clears ok,
+// so untrusted input can be parsed first and checked once at the end.
+struct ByteReader {
+    const uint8_t* data;
+    const uint8_t* end;
+    bool ok = true;
+
+    ByteReader(const uint8_t* begin, size_t size) : data(begin), end(begin + size) {}
+
+    size_t remaining() const { return end - data; }
+
+    uint64_t getLE(int bytes)
+    {
+        if (remaining() < (size_t)bytes)
+        {
+            ok = false;
+            data = end;
+            return 0;
+        }
+        uint64_t value = 0;
+        for (int i = 0; i < bytes; i++)
+        {
+            value |= (uint64_t)data[i] << (8 * i);
+        }
+        data += bytes;
+        return value;
+    }
+
+    uint64_t getVarint()
+    {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            if (data == end)
+            {
+                ok = false;
+                return 0;
+            }
+            uint8_t byte = *data++;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+            {
+                return value;
+            }
+        }
+        ok = false; // longer than any 64-bit value
+        return 0;
+    }
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef CAPTURE_H
+#define CAPTURE_H
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "chip8.h"
+#include "encode.h"
+#include "raster.h"
+
+enum CaptureFormat : uint8_t {
+    CAPTURE_GIF, // one animated GIF, timed at 60 Hz
+    CAPTURE_PNG, // a directory of frame_NNNNNN.png, numbered by the 60 Hz tick they appeared on
+    CAPTURE_RAW, // one file of frames, each a u32 tick, u16 width and u16 height (little-endian) then RGBA pixels
+};
+
+bool parseCaptureFormat(const char* name, CaptureFormat& format); // "gif", "png" or "raw"
+
+// records the frames a chip publishes, for looking at output without a browser. Hand submit()
+// to Chip8::setFrameListener: it copies the published planes into a bounded queue and returns,
+// and a background thread drops frames identical to the one before, rasterizes the rest and
+// encodes them. Emulation never waits for encoding; if the queue is full the frame is dropped
+// and counted instead.
+//
+// Every frame is drawn at 128x64 times the scale, low resolution pixels twice as big, so the
+// image size stays the same when a ROM switches resolution.
+class FrameCapture {
+    public:
+        FrameCapture(CaptureFormat format, const std::string& path, int scale = 2, size_t queueFrames = 256);
+        ~FrameCapture();
+        void submit(const Chip8& chip8); // on the emulating thread, after every publish
+        bool finish(const Chip8& chip8); // encodes what is queued and closes the output, false if anything failed
+        uint64_t getFramesEncoded() const { return encoded; } // distinct frames
+        uint64_t getDuplicates() const { return duplicates; }
+        uint64_t getDropped() const { return dropped; }
+        const std::string& getError() const { return error; }
+
+    private:
+        struct Frame {
+            std::array<uint64_t, DISPLAY_PLANES * DISPLAY_PLANE_WORDS> planes;
+            bool hires;
+            uint64_t tick; // 60 Hz ticks since reset
+        };
+
+        void encodeLoop();
+        void encode(const Frame& frame);
+        void emitGif(uint64_t endTick); // the pending GIF frame, shown until endTick
+        void fail(const std::string& message);
+
+        CaptureFormat format;
+        std::string path;
+        int scale;
+        Rasterizer rasterizer;
+        GifWriter gif;
+        FILE* raw = nullptr;
+        std::vector<uint8_t> indices; // GIF palette indices of the pending frame
+        uint64_t pendingTick = 0;
+        bool pending = false; // a GIF frame waiting to learn how long it is shown for
+        Frame last; // last frame encoded, to spot duplicates
+        bool haveLast = false;
+
+        // written by the emulating thread, read by the encoder under lock
+        std::mutex lock;
+        std::condition_variable wake;
+        std::vector<Frame> queue; // ring of queueFrames
+        size_t head = 0;
+        size_t count = 0;
+        bool closing = false;
+        uint64_t dropped = 0;
+
+        // encoder thread only until finish joins it
+        uint64_t encoded = 0;
+        uint64_t duplicates = 0;
+        std::string error;
+        std::thread worker;
+};
+
+#endif
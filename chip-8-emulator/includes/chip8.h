@@ -2,29 +2,178 @@
 #define CHIP8_H
 
 #include <array>
+#include <bitset>
 #include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "trace.h"
+#include "decode.h"
+#include "blocks.h"
+#include "state.h"
+#include "profile.h"
+#include "quirks.h"
+
+// conditions that end a runCycles/runFor batch before its budget is used up
+enum RunStop : uint8_t {
+    STOP_ON_KEY_WAIT = 1 << 0, // FX0A is blocked waiting for a key press
+    STOP_ON_DRAW = 1 << 1,     // a draw or clear made the frame dirty
+};
+
+// the framebuffer: SUPER-CHIP's 128x64 high resolution at most, on up to two XO-CHIP bit-planes.
+// Each row is DISPLAY_ROW_WORDS words with bit 63 of the first word as x = 0. In low resolution
+// (64x32) only the first word of the first 32 rows is used.
+//
+// Instructions draw into the live framebuffer. At every 60 Hz timer tick (the COSMAC VIP's vertical
+// blank), and on reset and state loads, the rows changed since the last publish are copied into
+// the back one of two presentation buffers, which then becomes the front. Hosts read the front in
+// place: it holds one whole frame and is not written until the next publish.
+const int DISPLAY_PLANES = 2;
+const int DISPLAY_MAX_WIDTH = 128;
+const int DISPLAY_MAX_HEIGHT = 64;
+const int DISPLAY_ROW_WORDS = DISPLAY_MAX_WIDTH / 64;
+const int DISPLAY_PLANE_WORDS = DISPLAY_MAX_HEIGHT * DISPLAY_ROW_WORDS;
 
 class Chip8 {
     public:
         Chip8(); //the constructor
         void loadROM(const uint8_t* romData, size_t size); //loads ROM
         void emulateCycle(); //fetch, decode and execute an opcode/instruction
+        uint32_t runCycles(uint32_t count, uint8_t stopMask = STOP_ON_KEY_WAIT); // run up to count cycles, returns cycles elapsed
+        uint32_t runFor(uint32_t microseconds, uint8_t stopMask = STOP_ON_KEY_WAIT); // run an emulated time budget, returns cycles elapsed
+        void setClockSpeed(uint32_t hz); // instructions per emulated second, timers stay at 60 Hz
+        uint32_t getClockSpeed() const { return clockSpeed; }
+        uint64_t getCycleCount() const { return cycleCount; } // emulated cycles since reset
+        uint16_t getPC() const { return PC; }
+        const std::vector<uint8_t>& getMemory() const { return memory; } // getMemorySize() bytes
+        size_t getMemorySize() const { return memory.size(); } // bytes the current quirk profile can address, 4 KB or 64 KB
+        uint16_t getIndex() const { return I; }
+        const std::array<uint8_t, 16>& getRegisters() const { return V; }
+        uint8_t getStackPointer() const { return SP; }
+        uint8_t getDelayTimer() const { return delayTimer; }
+        uint8_t getSoundTimer() const { return soundTimer; }
+        const std::array<uint8_t, 16>& getAudioPattern() const { return audioPattern; } // XO-CHIP sample loop, bit 7 of byte 0 first
+        uint8_t getPitch() const { return pitch; }
+        bool isWaitingForKey() const { return waitingForKey; } // FX0A is blocked until a key is pressed
+        void setBlockTranslation(bool enabled); // run straight-line code as translated blocks (off by default)
+        // decodes the code at each of starts ahead of time and, with block translation on, translates its
+        // blocks, e.g. from RomAnalysis::precompileHints after loadROM. Returns the blocks translated.
+        size_t precompile(const std::vector<uint16_t>& starts);
+        void setQuirks(QuirkProfile profile); // which implementation's instruction behaviour to follow, kept across reset
+        QuirkProfile getQuirks() const { return quirks; }
+        void setSeed(uint64_t value); // restart the CXNN random sequence from value, kept across reset
+        uint64_t getSeed() const { return seed; }
         void executeOpcode(uint16_t opcode);
+        // split an opcode into its kind and operands, with extended as Quirks<P>::extended of the profile it runs under
+        static DecodedOp decode(uint16_t opcode, bool extended);
         void reset(); // reset the emulator
-        uint8_t* getDisplayBuffer();
+        // the published frame, for hosts to show
+        const uint64_t* getFramePlane(int plane) const { return frames[frontFrame].planes.data() + plane * DISPLAY_PLANE_WORDS; }
+        int getFrameWidth() const { return frames[frontFrame].hires ? 128 : 64; }
+        int getFrameHeight() const { return frames[frontFrame].hires ? 64 : 32; }
+        uint32_t getFrameSequence() const { return frameSequence; } // bumped by every publish that changed the frame
+        uint64_t takeDirtyRows(); // rows of the published frame changed since the last call, bit y for row y, then clears them
+        uint64_t getPublishedRows() const { return publishedRows; } // rows the last publish changed, for frame listeners
+        // called with every frame published, on the thread running the chip, e.g. to capture them
+        void setFrameListener(std::function<void(const Chip8&)> listener) { frameListener = std::move(listener); }
+        // called when the tone starts or stops, or the XO-CHIP pattern or pitch changes, on the thread running the chip.
+        // cycle is the emulated time it happened at: getCycleCount() lags behind it while a batch is running.
+        void setSoundListener(std::function<void(const Chip8&, uint64_t cycle)> listener) { soundListener = std::move(listener); }
+        // the live framebuffer, as the last instruction left it, for tools and tests
+        int getDisplayWidth() const { return hires ? 128 : 64; }
+        int getDisplayHeight() const { return hires ? 64 : 32; }
+        uint8_t* getDisplayBuffer(); // one byte per pixel, bit n set if plane n is, unpacked on every call
+        const uint64_t* getDisplayPlane(int plane) const { return display.data() + plane * DISPLAY_PLANE_WORDS; } // rows as laid out above
+        uint64_t getDisplayHash() const; // FNV-1a over the rows, for comparing runs
         void setKeyState(uint8_t key, uint8_t state);
+        const char* drainTrace(); // pending per-instruction trace lines, empty unless built with CHIP8_TRACE_INSTR
+        std::vector<uint8_t> saveState() const; // whole machine as a versioned, portable blob
+        bool loadState(const uint8_t* data, size_t size); // false, leaving the machine untouched, if the blob is invalid
+        Snapshot takeSnapshot(); // cheap in-memory save, copies only the memory pages written since the last one
+        void restoreSnapshot(const Snapshot& snapshot);
+        std::string getProfileReport() const; // flat profile since the last clearProfile, empty unless built with CHIP8_PROFILE
+        std::string getProfileStacks() const; // the same cycles by call stack, in collapsed flamegraph format
+        void clearProfile();
 
     private:
-        std::array<uint8_t, 4096> memory{}; //4kb RAM
+        std::vector<uint8_t> memory; // as much as the quirk profile addresses, so only XO-CHIP machines carry 64 KB
         uint16_t PC; //program counter
         uint16_t I; //index register (for storing memory addresses)
-        std::array<uint8_t, 64 * 32> display{};
+        std::array<uint64_t, DISPLAY_PLANES * DISPLAY_PLANE_WORDS> display{}; // plane by plane, laid out as above
+        bool hires = false; // SUPER-CHIP 128x64 mode, switched by 00FF and 00FE
+        uint8_t planes = 1; // bit-planes drawn, cleared and scrolled, bit n for plane n (XO-CHIP FN01)
+        std::vector<uint8_t> unpackedDisplay; // byte-per-pixel copy for getDisplayBuffer, allocated on first use
+        uint64_t dirtyRows = ~0ULL; // rows of display changed since the last publish, bit y for row y
+        struct Frame {
+            std::array<uint64_t, DISPLAY_PLANES * DISPLAY_PLANE_WORDS> planes{};
+            bool hires = false;
+        };
+        std::array<Frame, 2> frames; // presentation buffers, see above
+        uint8_t frontFrame = 0;
+        uint32_t frameSequence = 0;
+        uint64_t publishedRows = 0; // rows the last publish copied, which the back buffer still lacks
+        uint64_t presentedRows = ~0ULL; // rows of the front changed since the last takeDirtyRows
+        std::function<void(const Chip8&)> frameListener;
+        std::function<void(const Chip8&, uint64_t)> soundListener;
         std::array<uint8_t, 16> V{}; //chip-8 has 16 registers (V0 through to VF)
         std::array<uint8_t, 16> keys{}; // chip-8 has 16 keys
         std::array<uint16_t, 16> stack; //stacks in chip-8 typically 16 levels deep
         uint8_t SP = 0; //stack pointer, initialise at 0
         uint8_t delayTimer = 0;
         uint8_t soundTimer = 0;
+        std::array<uint8_t, 16> flags{}; // SUPER-CHIP RPL user flags, FX75 and FX85
+        std::array<uint8_t, 16> audioPattern{}; // XO-CHIP 1-bit sample loop, set by F002
+        uint8_t pitch = 64; // XO-CHIP playback rate of audioPattern, 4000 * 2^((pitch - 64) / 48) Hz
+        uint32_t clockSpeed = 700; // emulated instructions per second
+        uint32_t timerPhase = 0; // progress towards the next 60 Hz timer tick, in 1/(60 * clockSpeed) s units
+        uint64_t cycleCount = 0; // emulated time, in cycles
+        uint32_t cycleFraction = 0; // part of a cycle left over from the last runFor, in microsecond-instructions
+        QuirkProfile quirks = QUIRKS_DEFAULT;
+        bool waitingForKey = false; // FX0A found no key pressed on its last attempt
+        bool drawn = false; // a draw or clear happened during the current batch
+        uint64_t seed = 1; // where the random sequence starts after construction or reset
+        uint64_t rngState; // xorshift64* state behind CXNN, never zero
+        std::bitset<MEMORY_PAGE_COUNT> dirtyPages; // memory pages written since the last snapshot, all set until the first
+        std::vector<std::shared_ptr<const MemoryPage>> sharedPages; // the last snapshot's pages
+        std::array<DecodedOp, CODE_SIZE> decodeCache{}; // decoded instruction starting at each address, OP_DECODE until first run
+        BlockCache blocks; // translated blocks, only filled while block translation is on
+#if CHIP8_TRACE_LEVEL >= CHIP8_TRACE_INSTR
+        TraceBuffer trace; // per-instruction log, only present in tracing builds
+#endif
+#if CHIP8_PROFILE
+        Profiler profile; // only present in profiling builds
+#endif
+
+        void advanceTime(uint32_t cycles); // move emulated time forward, ticking timers at 60 Hz
+        void tickTimers(uint64_t phase); // slow path of advanceTime, at least one tick is due
+        template <QuirkProfile P> void writeMemory(uint16_t address, uint8_t value); // store a byte, dropping stale decoded instructions over it
+        template <QuirkProfile P> uint16_t skippedLength() const; // size of the instruction after PC, which a skip steps over
+        template <QuirkProfile P, bool High> uint64_t drawSprite(const DecodedOp& op, uint64_t& changed); // DXYN on every selected plane, returns the pixels turned off
+        uint64_t* planeRows(int plane) { return display.data() + plane * DISPLAY_PLANE_WORDS; }
+        void clearDisplay(); // blank the selected planes, marking the rows that had pixels set as dirty
+        void scrollDisplay(int down, int right); // move the selected planes by whole pixels, in the current resolution
+        void setResolution(bool high); // 00FE and 00FF, clearing every plane
+        uint8_t storedPlanes() const; // the first plane, and the second if it has any pixel set: what states and hashes cover
+        void resizeMemory(); // to what the quirk profile addresses, zeroing any bytes added
+        void quirksChanged(QuirkProfile previous); // resizes memory, and drops decoded code if the instruction set changed
+        void present(); // publish display as the front frame, if anything changed since the last time
+        void soundChanged(uint64_t cycle) { if (soundListener) soundListener(*this, cycle); }
+        uint8_t nextRandom(); // next byte of this instance's random sequence
+        void saveMachine(std::vector<uint8_t>& out) const; // everything but memory, appended in saveState layout
+        bool loadMachine(const uint8_t* data, size_t size); // inverse of saveMachine, validates before changing anything
+        bool replacePage(size_t page, const uint8_t* data); // restore one memory page, false if it was already equal
+        void execute(const DecodedOp& op); // run one decoded instruction under this instance's quirks
+        template <QuirkProfile P> void executeWith(const DecodedOp& op); // same, with the quirks fixed at compile time
+        template <QuirkProfile P> uint32_t runSlice(uint32_t budget, bool stopOnKey, bool stopOnDraw); // hot loop, no timer ticks inside
+        template <QuirkProfile P> uint32_t runBlocks(uint32_t budget, bool stopOnKey, bool stopOnDraw); // same, a translated block at a time
+        const Block& translateBlock(uint16_t start);
+
+        // one handler per OpKind, instantiated once per quirk profile
+        template <QuirkProfile P> void opDecode(const DecodedOp& op);
+#define CHIP8_HANDLER(name) template <QuirkProfile P> void op##name(const DecodedOp& op);
+        CHIP8_OPCODES(CHIP8_HANDLER)
+#undef CHIP8_HANDLER
+        void opUnknown(const DecodedOp& op);
 };
 
-#endif
\ No newline at end of file
+#endif
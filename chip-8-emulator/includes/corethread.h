@@ -0,0 +1,113 @@
+#ifndef CORETHREAD_H
+#define CORETHREAD_H
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "chip8.h"
+
+// whether CoreThread::start can give the chip a thread of its own: always natively, in the web
+// build only when built with THREADS=1 (Emscripten pthreads, which need a cross-origin isolated page)
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define CHIP8_THREADS 0
+#else
+#define CHIP8_THREADS 1
+#endif
+
+// runs a chip in real time on a thread of its own, so nothing the host does between frames (layout,
+// garbage collection, logging) can stall emulation, or stretch the time between a key press and the
+// frame that shows it.
+//
+// Keys and frames cross between threads without locks. setKeyState sets a bit the core picks up at
+// the start of its next slice, at most 1/SLICE_HZ s later. Every frame the chip publishes is copied
+// into a triple buffer with the rows it changed: the core always has a buffer to write and never
+// waits, and takeFrame moves the host to the newest whole frame, skipping any it was too slow to see.
+// The host reads that buffer in place, nothing is copied or compared on its side. Everything else that
+// touches the chip (loading, reset, states, rewind) goes through hold(), which keeps it between
+// slices; a slice is a fraction of a millisecond of work, so the wait is short.
+//
+// Without start() nothing runs on its own: the host drives the chip with run() (the web build's
+// single-threaded fallback), and keys and frames take the same path.
+class CoreThread {
+    public:
+        static constexpr uint32_t SLICE_HZ = 240; // slices per second on the core's thread
+        static constexpr uint32_t MAX_SLICE_MICROS = 100000; // after a stall, catch up at most this much emulated time
+
+        explicit CoreThread(Chip8& chip8); // takes over chip8's frame listener
+        ~CoreThread(); // stops the thread, if started
+        bool start(); // run in real time from now on, false if this build has no threads
+        bool isStarted() const { return worker.joinable(); }
+        void setPaused(bool paused); // stop or resume emulated time, the thread stays up
+        std::unique_lock<std::mutex> hold(); // keeps the chip between slices until the lock is released
+
+        // with the chip held and pending keys applied, runs work(chip) and then the slice listener.
+        // This is how the core's thread runs each slice, and how a host without one steps the chip.
+        template <typename Work>
+        auto run(Work&& work)
+        {
+            std::unique_lock<std::mutex> held = hold();
+            applyKeys();
+            auto result = work(chip8);
+            if (sliceListener)
+            {
+                sliceListener(chip8);
+            }
+            return result;
+        }
+
+        void setKeyState(uint8_t key, uint8_t state); // any thread, never waits
+        // how the keys reach the chip, by default chip8.setKeyState, e.g. to record them on the way
+        void setKeyHandler(std::function<void(Chip8&, uint8_t key, uint8_t state)> handler) { keyHandler = std::move(handler); }
+        // called after every slice with the chip held, on the thread that ran it
+        void setSliceListener(std::function<void(Chip8&)> listener) { sliceListener = std::move(listener); }
+
+        // host side of the frames: takeFrame moves to the newest published frame, false if nothing
+        // was published since. The rest read the frame taken, laid out like Chip8's own.
+        bool takeFrame();
+        const uint64_t* getFramePlane(int plane) const { return frames[front].planes.data() + plane * DISPLAY_PLANE_WORDS; }
+        int getFrameWidth() const { return frames[front].hires ? 128 : 64; }
+        int getFrameHeight() const { return frames[front].hires ? 64 : 32; }
+        uint32_t getFrameSequence() const { return frames[front].sequence; }
+        uint64_t takeDirtyRows(); // rows changed by the frames taken since the last call, then clears them
+
+    private:
+        struct Frame {
+            std::array<uint64_t, DISPLAY_PLANES * DISPLAY_PLANE_WORDS> planes{};
+            bool hires = false;
+            uint32_t sequence = 0;
+            uint64_t rows = 0; // changed since the host last took a frame, at least
+        };
+        static constexpr uint8_t FRESH = 4; // in middle: published and not taken yet
+
+        void publish(const Chip8& published); // core side, with the chip held
+        void applyKeys(); // core side, with the chip held
+        void loop();
+
+        Chip8& chip8;
+        std::mutex lock; // held while the chip runs a slice or the host touches it
+        std::function<void(Chip8&, uint8_t, uint8_t)> keyHandler;
+        std::function<void(Chip8&)> sliceListener;
+
+        std::atomic<uint32_t> heldKeys{0}; // bit n while key n is down
+        std::atomic<uint32_t> tappedKeys{0}; // pressed since the last slice, so a tap between two slices still lands
+        uint32_t appliedKeys = 0; // as the chip last saw them
+
+        std::array<Frame, 3> frames; // triple buffer
+        uint8_t back = 0; // core only: the buffer publish writes
+        uint64_t untakenRows = ~0ULL; // core only: rows changed since the last frame the host is known to have taken
+        std::atomic<uint8_t> middle{1}; // the buffer changing hands, with FRESH once written
+        uint8_t front = 2; // host only: the buffer takeFrame got last, stable until the next takeFrame
+        uint64_t shownRows = ~0ULL; // host only: rows changed since the last takeDirtyRows
+
+        std::mutex control; // guards paused and quitting, for the thread to sleep on
+        std::condition_variable wake;
+        bool paused = false;
+        bool quitting = false;
+        std::thread worker;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef DECODE_H
+#define DECODE_H
+
+#include <cstdint>
+
+// every instruction the interpreter knows, named after its opcode pattern. The OpKind enum and
+// both dispatch tables in chip8.cpp are generated from this list so they can't get out of step.
+// The SUPER-CHIP and XO-CHIP additions are only decoded under profiles with Quirks<P>::extended,
+// elsewhere they are what they always were: machine code calls, a 5XYN that never skips, or invalid.
+#define CHIP8_OPCODES(X) \
+    X(00E0) X(00EE) X(0NNN) X(00CN) X(00DN) X(00FB) X(00FC) X(00FD) X(00FE) X(00FF) \
+    X(1NNN) X(2NNN) X(3XNN) X(4XNN) X(5XY0) X(5XY2) X(5XY3) X(6XNN) X(7XNN) \
+    X(8XY0) X(8XY1) X(8XY2) X(8XY3) X(8XY4) X(8XY5) X(8XY6) X(8XY7) X(8XYE) \
+    X(9XY0) X(ANNN) X(BNNN) X(CXNN) X(DXYN) X(EX9E) X(EXA1) \
+    X(F000) X(FN01) X(F002) X(FX07) X(FX0A) X(FX15) X(FX18) X(FX1E) X(FX29) X(FX30) X(FX33) X(FX3A) \
+    X(FX55) X(FX65) X(FX75) X(FX85)
+
+#define CHIP8_OP_KIND(name) OP_##name,
+enum OpKind : uint8_t {
+    OP_DECODE, // decode cache entry not filled in yet
+    CHIP8_OPCODES(CHIP8_OP_KIND)
+    OP_UNKNOWN,
+    OP_KIND_COUNT
+};
+#undef CHIP8_OP_KIND
+
+// an opcode with its operands already extracted, so executing it needs no masking or switching
+struct DecodedOp {
+    OpKind kind;
+    uint8_t X;
+    uint8_t Y;
+    uint8_t N;
+    uint8_t NN;
+    uint16_t NNN;
+};
+
+// coarse groups of instructions, for reports that don't need every opcode on its own line
+enum OpClass : uint8_t {
+    CLASS_DISPLAY, // 00E0, DXYN, scrolls, resolution and plane changes
+    CLASS_FLOW,    // jumps, calls, returns, machine code calls
+    CLASS_SKIP,    // register and immediate compares
+    CLASS_KEY,     // key skips and the FX0A key wait
+    CLASS_LOAD,    // 6XNN, 8XY0, ANNN, F000
+    CLASS_ALU,     // 7XNN, 8XY1-8XYE, FX1E
+    CLASS_RANDOM,  // CXNN
+    CLASS_TIMER,   // FX07, FX15, FX18
+    CLASS_MEMORY,  // fonts, BCD, register stores and loads, RPL flags
+    CLASS_AUDIO,   // F002, FX3A
+    CLASS_OTHER,   // unknown opcodes
+    OP_CLASS_COUNT
+};
+
+// instructions that change what the sound output plays: the sound timer, XO-CHIP pattern and pitch
+constexpr bool changesSound(OpKind kind) { return kind == OP_FX18 || kind == OP_F002 || kind == OP_FX3A; }
+
+bool isExtendedOp(OpKind kind); // a SUPER-CHIP or XO-CHIP addition
+
+OpClass opClass(OpKind kind);
+const char* opClassName(OpClass group); // short lowercase name, e.g. "alu"
+const char* opKindName(OpKind kind); // opcode pattern, e.g. "8XY4"
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef ENCODE_H
+#define ENCODE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// encoders for captured frames and sound, written for CHIP-8 output (few colours, long runs, rows
+// repeated by scaling) and needing no libraries
+
+// a PNG of an RGBA8888 image. Compressed with fixed-Huffman deflate that only looks for repeats of
+// the previous pixel and of the row above, which is most of a scaled CHIP-8 frame.
+std::vector<uint8_t> encodePNG(const uint32_t* pixels, int width, int height);
+
+// an animated, looping GIF with a four-colour global palette, written to disk frame by frame.
+// Each frame only stores the rows that changed since the one before.
+class GifWriter {
+    public:
+        ~GifWriter();
+        bool open(const std::string& path, int width, int height, const uint32_t palette[4]); // palette as RGBA words
+        void addFrame(const uint8_t* indices, uint32_t delayCentiseconds); // width * height palette indices
+        bool close(); // writes the trailer, false if anything failed to write
+
+    private:
+        void writeImage(int top, int rows, const uint8_t* indices);
+
+        FILE* file = nullptr;
+        int width = 0;
+        int height = 0;
+        std::vector<uint8_t> previous; // last frame's indices
+        bool first = true;
+        std::vector<uint8_t> out; // block being assembled
+};
+
+// a mono 16-bit PCM WAV file, written as samples arrive. The sizes in the header are filled in by close().
+class WavWriter {
+    public:
+        ~WavWriter();
+        bool open(const std::string& path, uint32_t sampleRate);
+        bool write(const int16_t* samples, size_t count);
+        bool close(); // false if anything failed to write
+
+    private:
+        FILE* file = nullptr;
+        uint64_t samplesWritten = 0;
+        bool failed = false;
+};
+
+#endif
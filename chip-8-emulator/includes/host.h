@@ -0,0 +1,10 @@
+#ifndef HOST_H
+#define HOST_H
+
+// everything the core needs from whatever is running it. Each build links exactly one
+// implementation: src/host_web.cpp for the browser, src/host_native.cpp for the headless tools.
+
+// show a finished log line to the user (errors, ROM loaded, reset, ...)
+void hostLog(const char* line);
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef MOVIE_H
+#define MOVIE_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "quirks.h"
+
+class Chip8;
+
+// a key going down (state 1) or up (state 0) once the machine has run `cycle` cycles
+struct KeyEvent {
+    uint64_t cycle;
+    uint8_t key;
+    uint8_t state;
+};
+
+// a recorded session: which ROM, how the machine was set up and every key change, tagged with
+// the cycle it happened on. Starting from power-on with the same ROM, seed and clock speed and
+// feeding the keys back at the same cycles reproduces the session exactly.
+struct Movie {
+    uint64_t romHash = 0;         // hashROM of the ROM it was recorded on
+    uint64_t seed = 1;            // CXNN seed the machine started with
+    uint32_t clockSpeed = 700;
+    QuirkProfile quirks = QUIRKS_DEFAULT;
+    uint64_t length = 0;          // cycles from power-on to the end of the recording
+    uint64_t displayHash = 0;     // getDisplayHash at the end of the recording, 0 if unknown
+    std::vector<KeyEvent> keys;   // sorted by cycle
+};
+
+// movie files start with this magic and a version, bumped whenever the layout changes
+const uint8_t MOVIE_MAGIC[4] = {'C', '8', 'M', 'V'};
+const uint16_t MOVIE_VERSION = 2; // version 1 movies, without quirks, still load
+
+uint64_t hashROM(const uint8_t* data, size_t size); // FNV-1a, identifies a ROM image
+std::vector<uint8_t> saveMovie(const Movie& movie);
+bool loadMovie(const uint8_t* data, size_t size, Movie& movie, std::string& error);
+
+// records a session as it is played. Every key change has to go through keyChanged so it is
+// tagged with the cycle the machine is at when it happens.
+class MovieRecorder {
+    public:
+        // powers the machine on with the ROM and seed, then starts recording from there
+        void start(Chip8& chip8, const uint8_t* rom, size_t size, uint64_t seed);
+        void keyChanged(Chip8& chip8, uint8_t key, uint8_t state); // applies the change and records it
+        Movie finish(const Chip8& chip8); // stops recording, noting the length and final display
+        bool isRecording() const { return recording; }
+
+    private:
+        bool recording = false;
+        Movie movie;
+        std::array<uint8_t, 16> keyStates{}; // as last recorded, to drop repeats
+};
+
+// replays a movie into a machine, feeding each key change in at exactly the cycle it was recorded on
+class MoviePlayer {
+    public:
+        // powers the machine on the way the recording did, false if the ROM isn't the one recorded on
+        bool start(Chip8& chip8, const Movie& movie, const uint8_t* rom, size_t size);
+        uint64_t run(Chip8& chip8, uint64_t cycles); // run up to cycles more, not past the end, returns cycles run
+        bool isFinished(const Chip8& chip8) const;
+
+    private:
+        const Movie* movie = nullptr;
+        size_t nextKey = 0;
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "decode.h"
+
+// profiling, chosen at compile time with -DCHIP8_PROFILE=1. Off by default, and when off the
+// interpreter carries no profiling code or data at all.
+#ifndef CHIP8_PROFILE
+#define CHIP8_PROFILE 0
+#endif
+
+// where a ROM spends its cycles: per instruction kind, per address and per call stack, plus the
+// cycles burnt in FX0A key waits and the host time spent drawing
+class Profiler {
+    public:
+        Profiler();
+
+        // n cycles spent on the instruction of the given kind at pc
+        void instruction(uint16_t pc, OpKind kind, uint64_t cycles = 1)
+        {
+            kindCounts[kind] += cycles;
+            pcCounts[pc & 0x0FFF] += cycles;
+            contextCounts[context] += cycles;
+        }
+        // the OP_DECODE just counted turned out to be kind, after the first run at its address
+        void decoded(OpKind kind)
+        {
+            kindCounts[OP_DECODE]--;
+            kindCounts[kind]++;
+        }
+        void keyWait(uint64_t cycles) { keyWaitCycles += cycles; }
+        // rebuilds the current call stack from the return addresses on the CHIP-8 stack. Only called
+        // when the stack changes, so instruction() never has to look at it.
+        void enterContext(const uint16_t* stack, uint8_t depth, const uint8_t* memory);
+        void clear();
+
+        std::string report(const uint8_t* memory, bool extended) const; // flat profile as a text table, opcodes decoded as extended says
+        std::string collapsed() const; // "main;sub_2A0;sub_31C cycles" lines, for flamegraph.pl and speedscope
+
+        // measures one DXYN, from construction to destruction
+        class DrawTimer {
+            public:
+                explicit DrawTimer(Profiler& profiler) : profiler(profiler), start(std::chrono::steady_clock::now()) {}
+                ~DrawTimer()
+                {
+                    auto elapsed = std::chrono::steady_clock::now() - start;
+                    profiler.drawNanos += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+                    profiler.draws++;
+                }
+
+            private:
+                Profiler& profiler;
+                std::chrono::steady_clock::time_point start;
+        };
+
+    private:
+        // one node per distinct call stack, node 0 is the top level of the ROM
+        struct Context {
+            uint32_t parent;
+            uint16_t entry; // address of the subroutine, or of the call when that isn't a 2NNN any more
+            bool direct;    // entry is the subroutine, reached through a 2NNN
+        };
+
+        std::array<uint64_t, OP_KIND_COUNT> kindCounts{};
+        std::array<uint64_t, 4096> pcCounts{};
+        uint64_t keyWaitCycles = 0;
+        uint64_t draws = 0;
+        uint64_t drawNanos = 0;
+        std::vector<Context> contexts;
+        std::vector<uint64_t> contextCounts; // cycles spent in each context itself, not its callees
+        std::unordered_map<uint64_t, uint32_t> children; // parent << 17 | direct << 16 | entry -> context
+        uint32_t context = 0; // context of the instruction running now
+};
+
+#if CHIP8_PROFILE
+#define PROFILE_INSTR(kind) profile.instruction(PC, kind)
+#define PROFILE_IDLE(kind, cycles) profile.instruction(PC, kind, cycles)
+#define PROFILE_DECODED(kind) profile.decoded(kind)
+#define PROFILE_KEY_WAIT(cycles) profile.keyWait(cycles)
+#define PROFILE_CALLS() profile.enterContext(stack.data(), SP, memory.data())
+#define PROFILE_DRAW() Profiler::DrawTimer profileDraw(profile)
+#else
+#define PROFILE_INSTR(kind) ((void)0)
+#define PROFILE_IDLE(kind, cycles) ((void)0)
+#define PROFILE_DECODED(kind) ((void)0)
+#define PROFILE_KEY_WAIT(cycles) ((void)0)
+#define PROFILE_CALLS() ((void)0)
+#define PROFILE_DRAW() ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef QUIRKS_H
+#define QUIRKS_H
+
+#include <cstdint>
+
+// the CHIP-8 implementations ROMs were written for disagree on a handful of instructions. Each
+// profile is one such implementation, and the interpreter loops are compiled once per profile.
+#define CHIP8_QUIRK_PROFILES(X) X(DEFAULT) X(COSMAC_VIP) X(CHIP48) X(SUPER_CHIP) X(XO_CHIP)
+
+#define CHIP8_QUIRK_PROFILE(name) QUIRKS_##name,
+enum QuirkProfile : uint8_t {
+    CHIP8_QUIRK_PROFILES(CHIP8_QUIRK_PROFILE)
+    QUIRK_PROFILE_COUNT
+};
+#undef CHIP8_QUIRK_PROFILE
+
+const char* quirkProfileName(QuirkProfile profile); // e.g. "cosmac-vip"
+bool parseQuirkProfile(const char* name, QuirkProfile& profile); // inverse of quirkProfileName
+uint32_t quirkMemorySize(QuirkProfile profile); // bytes of memory the profile can address
+bool quirkExtended(QuirkProfile profile); // Quirks<profile>::extended, for code that isn't compiled per profile
+
+// where FX55 and FX65 leave I
+enum IndexStep : uint8_t {
+    INDEX_UNCHANGED,     // I stays put
+    INDEX_PLUS_X,        // I += X
+    INDEX_PLUS_X_PLUS_1, // I += X + 1, just past the last register stored or loaded
+};
+
+// the behaviour of one profile, as constants so the handlers need no runtime checks
+template <QuirkProfile P>
+struct Quirks;
+
+// what this emulator always did: shifts on VX, I unchanged, BNNN on V0, sprites wrap around
+template <>
+struct Quirks<QUIRKS_DEFAULT> {
+    static constexpr bool resetVF = false;    // 8XY1, 8XY2 and 8XY3 clear VF
+    static constexpr bool shiftVX = true;     // 8XY6 and 8XYE shift VX in place instead of VY into VX
+    static constexpr IndexStep memoryIndex = INDEX_UNCHANGED;
+    static constexpr bool jumpVX = false;     // BNNN is BXNN, jumping to XNN + VX instead of NNN + V0
+    static constexpr bool clipSprites = false; // DXYN cuts sprites off at the screen edges instead of wrapping
+    static constexpr uint16_t memoryMask = 0x0FFF; // addresses through I wrap at 4 KB, or at 64 KB on XO-CHIP
+    static constexpr bool longSkips = false;  // skips step over all four bytes of an F000 NNNN
+    static constexpr bool extended = false;   // SUPER-CHIP and XO-CHIP instructions decode, otherwise they do nothing and DXY0 draws no rows
+};
+
+template <>
+struct Quirks<QUIRKS_COSMAC_VIP> {
+    static constexpr bool resetVF = true;
+    static constexpr bool shiftVX = false;
+    static constexpr IndexStep memoryIndex = INDEX_PLUS_X_PLUS_1;
+    static constexpr bool jumpVX = false;
+    static constexpr bool clipSprites = true;
+    static constexpr uint16_t memoryMask = 0x0FFF;
+    static constexpr bool longSkips = false;
+    static constexpr bool extended = false;
+};
+
+template <>
+struct Quirks<QUIRKS_CHIP48> {
+    static constexpr bool resetVF = false;
+    static constexpr bool shiftVX = true;
+    static constexpr IndexStep memoryIndex = INDEX_PLUS_X;
+    static constexpr bool jumpVX = true;
+    static constexpr bool clipSprites = true;
+    static constexpr uint16_t memoryMask = 0x0FFF;
+    static constexpr bool longSkips = false;
+    static constexpr bool extended = false;
+};
+
+template <>
+struct Quirks<QUIRKS_SUPER_CHIP> {
+    static constexpr bool resetVF = false;
+    static constexpr bool shiftVX = true;
+    static constexpr IndexStep memoryIndex = INDEX_UNCHANGED;
+    static constexpr bool jumpVX = true;
+    static constexpr bool clipSprites = true;
+    static constexpr uint16_t memoryMask = 0x0FFF;
+    static constexpr bool longSkips = false;
+    static constexpr bool extended = true;
+};
+
+template <>
+struct Quirks<QUIRKS_XO_CHIP> {
+    static constexpr bool resetVF = false;
+    static constexpr bool shiftVX = false;
+    static constexpr IndexStep memoryIndex = INDEX_PLUS_X_PLUS_1;
+    static constexpr bool jumpVX = false;
+    static constexpr bool clipSprites = false;
+    static constexpr uint16_t memoryMask = 0xFFFF;
+    static constexpr bool longSkips = true;
+    static constexpr bool extended = true;
+};
+
+#endif
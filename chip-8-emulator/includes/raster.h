@@ -0,0 +1,53 @@
+#ifndef RASTER_H
+#define RASTER_H
+
+#include <cstdint>
+#include <vector>
+
+class Chip8;
+
+// the rasterizer expands pixels with SSE2, NEON or wasm SIMD, whichever the compiler targets.
+// -DCHIP8_SIMD=0 forces the plain loops, which produce the same image.
+#ifndef CHIP8_SIMD
+#if defined(__SSE2__) || defined(__ARM_NEON) || defined(__wasm_simd128__)
+#define CHIP8_SIMD 1
+#else
+#define CHIP8_SIMD 0
+#endif
+#endif
+
+// turns a chip's published frame into a presentation-ready RGBA8888 image, one blit away from the
+// screen. Every CHIP-8 pixel becomes a scale x scale square in the palette entry for its plane
+// bits: 0 for off, 1 for the first plane, 2 for the second, 3 for both. Low and high resolution
+// go through the same code; only the rows passed to render are redrawn, the rest of the image is
+// kept from the call before.
+class Rasterizer {
+    public:
+        static constexpr int MAX_SCALE = 16;
+
+        Rasterizer();
+        void setScale(int factor); // screen pixels per CHIP-8 pixel each way, 1 to MAX_SCALE
+        int getScale() const { return scale; }
+        void setColor(int index, uint32_t rgb); // palette entry for plane bits index, as 0xRRGGBB
+        const uint32_t* getPalette() const { return palette; } // the four entries as RGBA words
+        // redraws the given rows of the published frame (all of them after a size, scale or palette
+        // change) and returns the image, getWidth() * getHeight() pixels as R, G, B, A bytes
+        const uint32_t* render(const Chip8& chip8, uint64_t rows);
+        // the same for planes laid out like Chip8::getFramePlane, e.g. a copy taken on another thread
+        const uint32_t* render(const uint64_t* first, const uint64_t* second, bool hires, uint64_t rows);
+        const uint32_t* getPixels() const { return pixels.data(); }
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+
+    private:
+        std::vector<uint32_t> pixels;
+        std::vector<uint32_t> line; // one row at 1x
+        std::vector<uint32_t> wideLine; // the same row scaled, with room for 3 pixels of overspill
+        uint32_t palette[4] = {}; // as little-endian words of R, G, B, A bytes
+        int scale = 1;
+        int width = 0;
+        int height = 0;
+        bool stale = true; // scale or palette changed since the last render
+};
+
+#endif
@@ -0,0 +1,45 @@
+#ifndef REWIND_H
+#define REWIND_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class Chip8;
+
+// the last few seconds of a machine, one saved state per frame, to step back through.
+// Only the newest state is kept whole; every older frame is stored as the XOR of two
+// neighbouring states, run-length encoded, in a byte ring of fixed size. Most of a state is
+// the same from one frame to the next, so a frame typically costs well under a hundred bytes and the
+// default budget holds well over a minute at 60 frames per second. When the ring is full the
+// oldest frames are dropped.
+class RewindBuffer {
+    public:
+        static constexpr size_t DEFAULT_BUDGET = 2 * 1024 * 1024;
+
+        explicit RewindBuffer(size_t budgetBytes = DEFAULT_BUDGET);
+        void setBudget(size_t budgetBytes); // resize the ring, forgetting all history
+        void record(const Chip8& chip8); // call once per frame
+        bool stepBack(Chip8& chip8); // restore the frame before the last one recorded, false if there is none
+        void clear();
+        size_t getFrameCount() const; // frames that can still be restored, including the newest
+        size_t getBytesUsed() const { return used; } // of the ring, the newest state and scratch space are extra
+
+    private:
+        struct Delta {
+            size_t offset; // start in the ring, may wrap around its end
+            size_t length;
+            size_t stateSize; // of the older of the two states, which may differ in length
+        };
+
+        std::vector<uint8_t> ring;
+        std::deque<Delta> deltas; // oldest first
+        size_t used = 0;
+        std::vector<uint8_t> newest; // the last recorded state, whole
+        std::vector<uint8_t> scratch;
+
+        void append(const std::vector<uint8_t>& delta, size_t stateSize);
+};
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef ROM_H
+#define ROM_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "state.h"
+
+// everything from 0x200 to the end of memory on XO-CHIP. Other profiles only take ROMs up to the
+// end of their 4 KB, Chip8::loadROM checks that.
+const size_t MAX_ROM_SIZE = MEMORY_SIZE - 0x200;
+
+// reads a ROM image from disk for the native tools. On failure returns false and puts the
+// reason in error.
+bool readROMFile(const std::string& path, std::vector<uint8_t>& data, std::string& error);
+
+// one ROM's bytes, never changed after loading and shared by every machine running it. Files
+// opened on Linux/macOS are mapped read-only instead of copied, so the page cache is the only copy.
+class RomImage {
+    public:
+        RomImage(std::vector<uint8_t> contents, const std::string& name); // keeps its own copy
+        RomImage(const uint8_t* mapping, size_t size, const std::string& name); // takes over a read-only mapping
+        ~RomImage();
+        RomImage(const RomImage&) = delete;
+        RomImage& operator=(const RomImage&) = delete;
+        const uint8_t* data() const { return bytes; }
+        size_t size() const { return length; }
+        uint64_t getHash() const { return hash; } // hashROM of the bytes
+        const std::string& getName() const { return name; } // file name, or whatever the caller called it
+
+    private:
+        std::vector<uint8_t> owned;
+        const uint8_t* bytes;
+        size_t length;
+        bool mapped;
+        uint64_t hash;
+        std::string name;
+};
+
+// every ROM loaded so far, addressed by content. A file is only read the first time its path is
+// opened, and identical ROMs reached by different paths or uploads share one image, so starting
+// any number of machines on a ROM costs one read and one copy of its bytes. Safe to share
+// between threads.
+class RomLibrary {
+    public:
+        std::shared_ptr<const RomImage> open(const std::string& path, std::string& error); // null on failure
+        std::shared_ptr<const RomImage> add(const uint8_t* data, size_t size, const std::string& name); // null if empty or too large
+        void addDirectory(const std::string& directory); // notes its files, opened only when find looks for them
+        std::shared_ptr<const RomImage> find(uint64_t hash); // null if no ROM known has that hash
+
+    private:
+        std::shared_ptr<const RomImage> load(const std::string& path, std::string& error); // open, with lock held
+        std::shared_ptr<const RomImage> share(std::shared_ptr<const RomImage> image); // the cached copy of its content
+
+        std::mutex lock;
+        std::map<uint64_t, std::shared_ptr<const RomImage>> images; // by hash
+        std::map<std::string, std::shared_ptr<const RomImage>> paths; // files opened so far
+        std::vector<std::string> unopened; // from addDirectory, not read yet
+};
+
+#endif
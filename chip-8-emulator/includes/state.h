@@ -0,0 +1,33 @@
+#ifndef STATE_H
+#define STATE_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// saveState blobs start with this magic and a version, bumped whenever the layout changes
+const uint8_t STATE_MAGIC[4] = {'C', '8', 'S', 'T'};
+const uint16_t STATE_VERSION = 3;
+
+// XO-CHIP can address 64 KB, everything else only the first 4 KB of it, and a machine only holds
+// as much as its profile addresses. Code always runs from the first 4 KB: jumps and calls only
+// take 12-bit addresses.
+const size_t MEMORY_SIZE = 0x10000;
+const size_t CODE_SIZE = 0x1000;
+
+// memory is snapshotted in pages so unchanged pages can be shared instead of copied
+const size_t MEMORY_PAGE_SIZE = 256;
+const size_t MEMORY_PAGE_COUNT = MEMORY_SIZE / MEMORY_PAGE_SIZE;
+using MemoryPage = std::array<uint8_t, MEMORY_PAGE_SIZE>;
+
+// an in-memory snapshot of a whole machine. Pages are immutable and shared with every other
+// snapshot taken while they were unchanged, so a snapshot only owns the pages written since the
+// one before it plus the registers, timers, keys and the display in use (about 400 bytes in low
+// resolution, 2 KB at most).
+struct Snapshot {
+    std::vector<std::shared_ptr<const MemoryPage>> pages; // as many as the machine's profile can address
+    std::vector<uint8_t> machine; // everything but memory, in the saveState layout
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+// trace levels, chosen at compile time with -DCHIP8_TRACE_LEVEL=<level>
+#define CHIP8_TRACE_OFF 0    // nothing is logged, the interpreter carries no logging code at all
+#define CHIP8_TRACE_ERRORS 1 // errors and lifecycle events (ROM loaded, reset), sent straight to the host
+#define CHIP8_TRACE_INSTR 2  // additionally every executed instruction, collected in a ring buffer
+
+#ifndef CHIP8_TRACE_LEVEL
+#define CHIP8_TRACE_LEVEL CHIP8_TRACE_ERRORS
+#endif
+
+// ring buffer sink for per-instruction trace lines, drained by the host once per frame
+class TraceBuffer {
+    public:
+        static constexpr size_t CAPACITY = 128;    // lines kept before the oldest is overwritten
+        static constexpr size_t LINE_LENGTH = 160; // longest line stored, longer lines are truncated
+
+        void log(const char* format, ...) __attribute__((format(printf, 2, 3)));
+        const char* drain(); // returns all pending lines joined by '\n' and empties the buffer
+
+    private:
+        std::array<std::array<char, LINE_LENGTH>, CAPACITY> lines{};
+        size_t head = 0;    // next slot to be written
+        size_t count = 0;   // lines currently held
+        size_t dropped = 0; // lines overwritten since the last drain
+        std::string drained;
+};
+
+// cold path: formats an event and passes it to the host (hostLog) immediately
+void traceEvent(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+// disabled trace calls sit inside sizeof: the format string is still checked and locals kept
+// only for logging don't warn, but nothing is evaluated and no code is emitted
+int traceDisabled(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+#if CHIP8_TRACE_LEVEL >= CHIP8_TRACE_ERRORS
+#define TRACE_EVENT(...) traceEvent(__VA_ARGS__)
+#else
+#define TRACE_EVENT(...) ((void)sizeof(traceDisabled(__VA_ARGS__)))
+#endif
+
+#if CHIP8_TRACE_LEVEL >= CHIP8_TRACE_INSTR
+#define TRACE_INSTR(...) trace.log(__VA_ARGS__)
+#else
+#define TRACE_INSTR(...) ((void)sizeof(traceDisabled(__VA_ARGS__)))
+#endif
+
+#endif
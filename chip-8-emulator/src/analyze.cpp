@@ -0,0 +1,468 @@
+#include "../includes/analyze.h"
+#include "../includes/blocks.h"
+#include "../includes/chip8.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    const uint16_t ROM_START = 0x200;
+    const int32_t I_UNVISITED = -2; // no path has reached the instruction yet
+    const int32_t I_UNKNOWN = -1;   // paths disagree, or I came from a register
+
+    // the quirks that change where code goes and where I points
+    struct Traits {
+        IndexStep memoryIndex;
+        uint32_t memoryMask;
+        bool longSkips;
+        bool extended;
+    };
+
+    template <QuirkProfile P>
+    Traits traitsOf()
+    {
+        return {Quirks<P>::memoryIndex, Quirks<P>::memoryMask, Quirks<P>::longSkips, Quirks<P>::extended};
+    }
+
+    Traits traits(QuirkProfile profile)
+    {
+        switch (profile)
+        {
+#define CHIP8_TRAITS(name) \
+    case QUIRKS_##name:    \
+        return traitsOf<QUIRKS_##name>();
+            CHIP8_QUIRK_PROFILES(CHIP8_TRAITS)
+#undef CHIP8_TRAITS
+        default:
+            return traitsOf<QUIRKS_DEFAULT>();
+        }
+    }
+
+    int32_t mergeIndex(int32_t known, int32_t incoming)
+    {
+        if (known == I_UNVISITED)
+        {
+            return incoming;
+        }
+        return known == incoming ? known : I_UNKNOWN;
+    }
+
+    struct Walk {
+        const std::vector<uint8_t> &memory;
+        Traits quirks;
+
+        uint16_t word(uint32_t address) const // fetched the way the interpreter does, wrapping at 4 KB
+        {
+            return (memory[address & 0x0FFF] << 8) | memory[(address + 1) & 0x0FFF];
+        }
+
+        DecodedOp decode(uint32_t address) const // as the profile decodes it
+        {
+            return Chip8::decode(word(address), quirks.extended);
+        }
+
+        uint16_t length(const DecodedOp &op) const
+        {
+            return op.kind == OP_F000 ? 4 : 2;
+        }
+
+        // I after the instruction, given I before it
+        int32_t indexAfter(uint16_t address, const DecodedOp &op, int32_t index) const
+        {
+            switch (op.kind)
+            {
+            case OP_ANNN:
+                return op.NNN;
+            case OP_F000:
+                return word(address + 2) & quirks.memoryMask;
+            case OP_FX1E:
+            case OP_FX29:
+            case OP_FX30:
+                return I_UNKNOWN;
+            case OP_FX55:
+            case OP_FX65:
+                if (index == I_UNKNOWN || quirks.memoryIndex == INDEX_UNCHANGED)
+                {
+                    return index;
+                }
+                return (index + op.X + (quirks.memoryIndex == INDEX_PLUS_X_PLUS_1)) & quirks.memoryMask;
+            default:
+                return index;
+            }
+        }
+
+        // where control can go after the instruction, with I on the way there
+        void successors(uint16_t address, const DecodedOp &op, int32_t index, std::vector<std::pair<uint16_t, int32_t>> &next) const
+        {
+            next.clear();
+            int32_t after = indexAfter(address, op, index);
+            switch (op.kind)
+            {
+            case OP_00EE: // returns go back to the call's return site, which the call already leads to
+            case OP_00FD:
+                return;
+            case OP_1NNN:
+                next.push_back({op.NNN, after});
+                return;
+            case OP_2NNN:
+                next.push_back({op.NNN, after});
+                next.push_back({(uint16_t)(address + 2), I_UNKNOWN}); // the subroutine may have moved I
+                return;
+            case OP_BNNN:
+                // only a table of jumps at the base is followed, the usual way BNNN is used
+                for (uint16_t entry = op.NNN; entry < op.NNN + 256 && (word(entry) & 0xF000) == 0x1000; entry += 2)
+                {
+                    next.push_back({entry, after});
+                }
+                return;
+            case OP_3XNN:
+            case OP_4XNN:
+            case OP_5XY0:
+            case OP_9XY0:
+            case OP_EX9E:
+            case OP_EXA1:
+            {
+                uint16_t skipped = quirks.longSkips && word(address + 2) == 0xF000 ? 4 : 2;
+                next.push_back({(uint16_t)(address + 2), after});
+                next.push_back({(uint16_t)(address + 2 + skipped), after});
+                return;
+            }
+            default:
+                next.push_back({(uint16_t)(address + length(op)), after});
+                return;
+            }
+        }
+
+        // bytes the instruction reads or writes through I, 0 if none
+        uint16_t accessLength(const DecodedOp &op, bool &write, bool xoChip) const
+        {
+            write = op.kind == OP_FX33 || op.kind == OP_FX55 || op.kind == OP_5XY2;
+            switch (op.kind)
+            {
+            case OP_DXYN: // a 16x16 sprite for N = 0 where that exists, and on XO-CHIP possibly one per plane
+                return (op.N ? op.N : quirks.extended ? 32 : 0) * (xoChip ? 2 : 1);
+            case OP_FX33:
+                return 3;
+            case OP_FX55:
+            case OP_FX65:
+                return op.X + 1;
+            case OP_5XY2:
+            case OP_5XY3:
+                return (op.X > op.Y ? op.X - op.Y : op.Y - op.X) + 1;
+            case OP_F002:
+                return 16;
+            default:
+                return 0;
+            }
+        }
+    };
+
+    // ROM file names are free text, escape what JSON needs escaped
+    std::string jsonString(const std::string &text)
+    {
+        std::string out = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if ((unsigned char)c < 0x20)
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+                out += escaped;
+            }
+            else
+            {
+                out += c;
+            }
+        }
+        return out + "\"";
+    }
+
+    void appendHex(std::string &out, uint32_t value)
+    {
+        char text[16];
+        snprintf(text, sizeof(text), "\"0x%03X\"", value);
+        out += text;
+    }
+}
+
+size_t RomAnalysis::countBytes(uint8_t bits) const
+{
+    return std::count_if(use.begin(), use.end(), [bits](uint8_t used) { return (used & bits) != 0; });
+}
+
+std::vector<uint16_t> RomAnalysis::precompileHints() const
+{
+    std::vector<uint16_t> hints;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        for (const CodeBlock &block : blocks)
+        {
+            if (block.inLoop == (pass == 0))
+            {
+                hints.push_back(block.start);
+            }
+        }
+    }
+    return hints;
+}
+
+RomAnalysis analyzeROM(const uint8_t *data, size_t size, QuirkProfile profile)
+{
+    RomAnalysis analysis;
+    analysis.profile = profile;
+    analysis.romSize = size;
+    analysis.use.assign(quirkMemorySize(profile), 0);
+    std::vector<uint8_t> memory(analysis.use.size(), 0);
+    std::copy_n(data, std::min(size, memory.size() - ROM_START), memory.begin() + ROM_START);
+    Walk walk{memory, traits(profile)};
+
+    // follow every path from 0x200, with I at each instruction merged over the paths reaching it,
+    // until nothing changes. I only ever goes from unvisited to a value to unknown, so this ends.
+    // code outside the ROM could only be written there at run time, which a static walk can't see, so
+    // paths leading out are noted and not followed
+    size_t romEnd = ROM_START + size;
+    auto outside = [&](uint32_t target) { return target < ROM_START || target >= romEnd; };
+    std::vector<int32_t> index(CODE_SIZE, I_UNVISITED);
+    std::vector<uint16_t> work = {ROM_START};
+    index[ROM_START] = 0; // I after reset
+    std::vector<std::pair<uint16_t, int32_t>> next;
+    while (!work.empty())
+    {
+        uint16_t address = work.back();
+        work.pop_back();
+        DecodedOp op = walk.decode(address);
+        walk.successors(address, op, index[address], next);
+        for (auto [target, after] : next)
+        {
+            target &= 0x0FFF;
+            if (outside(target))
+            {
+                continue;
+            }
+            int32_t merged = mergeIndex(index[target], after);
+            if (merged != index[target])
+            {
+                index[target] = merged;
+                work.push_back(target);
+            }
+        }
+    }
+
+    // now what every reachable instruction is, reads and writes, and the block boundaries
+    struct Store {
+        uint16_t address;
+        OpKind op;
+        int32_t index;
+        uint16_t length;
+    };
+    std::vector<Store> stores;
+    std::vector<uint8_t> leader(CODE_SIZE, 0);
+    std::vector<uint8_t> flowEnd(CODE_SIZE, 0); // the instruction ends its block
+    leader[ROM_START] = 1;
+    for (uint32_t address = 0; address < CODE_SIZE; address++)
+    {
+        if (index[address] == I_UNVISITED)
+        {
+            continue;
+        }
+        DecodedOp op = walk.decode(address);
+        for (uint16_t i = 0; i < walk.length(op); i++)
+        {
+            analysis.use[(address + i) & 0x0FFF] |= USE_CODE;
+        }
+        bool write = false;
+        uint16_t length = walk.accessLength(op, write, profile == QUIRKS_XO_CHIP);
+        if (length > 0)
+        {
+            int32_t base = index[address];
+            if (base != I_UNKNOWN)
+            {
+                for (uint32_t i = 0; i < length; i++)
+                {
+                    analysis.use[(base + i) & walk.quirks.memoryMask] |= write ? USE_WRITTEN : USE_READ;
+                }
+            }
+            if (write)
+            {
+                stores.push_back({(uint16_t)address, op.kind, base, length});
+            }
+        }
+
+        if (op.kind == OP_BNNN)
+        {
+            walk.successors(address, op, index[address], next);
+            analysis.notes.push_back({(uint16_t)address, NOTE_COMPUTED_JUMP, op.kind, op.NNN, (uint16_t)next.size()});
+        }
+        else if (op.kind == OP_UNKNOWN)
+        {
+            analysis.notes.push_back({(uint16_t)address, NOTE_INVALID, op.kind, address, 0});
+        }
+        else if (op.kind == OP_0NNN)
+        {
+            analysis.notes.push_back({(uint16_t)address, NOTE_MACHINE_CODE, op.kind, op.NNN, 0});
+        }
+        walk.successors(address, op, index[address], next);
+        for (const auto &edge : next)
+        {
+            if (outside(edge.first & 0x0FFF))
+            {
+                analysis.notes.push_back({(uint16_t)address, NOTE_OUTSIDE_ROM, op.kind, (uint32_t)(edge.first & 0x0FFF), 0});
+            }
+            if (changesFlow(op.kind))
+            {
+                leader[edge.first & 0x0FFF] = 1;
+            }
+        }
+        flowEnd[address] = changesFlow(op.kind); // not an unknown opcode, which the interpreter steps over
+    }
+
+    // a store is only a problem if it can land on code: for certain with a known I, possibly without
+    for (const Store &store : stores)
+    {
+        if (store.index == I_UNKNOWN)
+        {
+            analysis.notes.push_back({store.address, NOTE_UNKNOWN_STORE, store.op, 0, store.length});
+            continue;
+        }
+        for (uint32_t i = 0; i < store.length; i++)
+        {
+            if (analysis.use[(store.index + i) & walk.quirks.memoryMask] & USE_CODE)
+            {
+                analysis.notes.push_back({store.address, NOTE_CODE_STORE, store.op, (uint32_t)store.index, store.length});
+                break;
+            }
+        }
+    }
+    std::stable_sort(analysis.notes.begin(), analysis.notes.end(),
+                     [](const AnalysisNote &a, const AnalysisNote &b) { return a.address < b.address; });
+
+    // blocks run from a leader to the first instruction that changes flow or falls into another leader
+    std::vector<int32_t> blockAt(CODE_SIZE, -1);
+    std::vector<uint16_t> lastInstruction; // per block
+    for (uint32_t start = 0; start < CODE_SIZE; start++)
+    {
+        if (!leader[start] || index[start] == I_UNVISITED)
+        {
+            continue;
+        }
+        CodeBlock block{(uint16_t)start, (uint16_t)start, {}, false};
+        uint16_t address = start;
+        for (size_t steps = 0; steps < CODE_SIZE / 2; steps++)
+        {
+            DecodedOp op = walk.decode(address);
+            uint16_t following = (address + walk.length(op)) & 0x0FFF;
+            walk.successors(address, op, index[address], next);
+            if (flowEnd[address] || leader[following] || index[following] == I_UNVISITED)
+            {
+                block.end = address + walk.length(op);
+                for (const auto &edge : next)
+                {
+                    block.successors.push_back(edge.first & 0x0FFF);
+                }
+                lastInstruction.push_back(address);
+                break;
+            }
+            address = following;
+        }
+        blockAt[start] = analysis.blocks.size();
+        analysis.blocks.push_back(block);
+    }
+
+    // loops: everything from the target of a backward jump to its source, then whatever is called
+    // from inside one, which runs as often as the loop does
+    std::vector<uint16_t> hot;
+    for (size_t b = 0; b < analysis.blocks.size(); b++)
+    {
+        const CodeBlock &block = analysis.blocks[b];
+        uint16_t last = lastInstruction[b];
+        bool call = (walk.word(last) & 0xF000) == 0x2000;
+        for (uint16_t target : block.successors)
+        {
+            if (target > block.start || (call && target == (walk.word(last) & 0x0FFF)))
+            {
+                continue;
+            }
+            for (CodeBlock &inside : analysis.blocks)
+            {
+                if (inside.start >= target && inside.start <= block.start && !inside.inLoop)
+                {
+                    inside.inLoop = true;
+                    hot.push_back(inside.start);
+                }
+            }
+        }
+    }
+    while (!hot.empty())
+    {
+        const CodeBlock &block = analysis.blocks[blockAt[hot.back()]];
+        hot.pop_back();
+        for (uint16_t target : block.successors)
+        {
+            if (blockAt[target] >= 0 && !analysis.blocks[blockAt[target]].inLoop)
+            {
+                analysis.blocks[blockAt[target]].inLoop = true;
+                hot.push_back(target);
+            }
+        }
+    }
+    return analysis;
+}
+
+const char *noteKindName(NoteKind kind)
+{
+    const char *const names[] = {"computed_jump", "code_store", "unknown_store", "invalid", "machine_code", "outside_rom"};
+    return kind <= NOTE_OUTSIDE_ROM ? names[kind] : "unknown";
+}
+
+std::string formatAnalysis(const RomAnalysis &analysis, const std::string &name)
+{
+    char text[256];
+    snprintf(text, sizeof(text),
+             ", \"quirks\": \"%s\", \"size\": %zu, \"code_bytes\": %zu, \"data_bytes\": %zu, "
+             "\"code_read_as_data\": %zu, \"blocks\": [",
+             quirkProfileName(analysis.profile), analysis.romSize, analysis.countBytes(USE_CODE),
+             analysis.countBytes(USE_READ | USE_WRITTEN),
+             (size_t)std::count(analysis.use.begin(), analysis.use.end(), USE_CODE | USE_READ));
+    std::string out = "{\"name\": " + jsonString(name) + text;
+    for (size_t i = 0; i < analysis.blocks.size(); i++)
+    {
+        const CodeBlock &block = analysis.blocks[i];
+        out += i ? ", {\"start\": " : "{\"start\": ";
+        appendHex(out, block.start);
+        out += ", \"end\": ";
+        appendHex(out, block.end);
+        out += ", \"next\": [";
+        for (size_t j = 0; j < block.successors.size(); j++)
+        {
+            out += j ? ", " : "";
+            appendHex(out, block.successors[j]);
+        }
+        out += block.inLoop ? "], \"loop\": true}" : "], \"loop\": false}";
+    }
+    out += "], \"notes\": [";
+    for (size_t i = 0; i < analysis.notes.size(); i++)
+    {
+        const AnalysisNote &note = analysis.notes[i];
+        out += i ? ", {\"address\": " : "{\"address\": ";
+        appendHex(out, note.address);
+        snprintf(text, sizeof(text), ", \"kind\": \"%s\", \"op\": \"%s\", \"target\": ", noteKindName(note.kind), opKindName(note.op));
+        out += text;
+        appendHex(out, note.target);
+        snprintf(text, sizeof(text), ", \"length\": %u}", note.length);
+        out += text;
+    }
+    out += "], \"hints\": [";
+    std::vector<uint16_t> hints = analysis.precompileHints();
+    for (size_t i = 0; i < hints.size(); i++)
+    {
+        out += i ? ", " : "";
+        appendHex(out, hints[i]);
+    }
+    out += "]}";
+    return out;
+}
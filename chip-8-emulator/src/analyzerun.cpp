@@ -0,0 +1,90 @@
+// chip8-analyze: walks ROMs statically, without running them, and prints one JSON line per ROM:
+// how many bytes are code and data, the control-flow graph as basic blocks, anything that can't
+// be followed or may rewrite code (BNNN computed jumps, stores into code), and the blocks worth
+// translating ahead of time (chip8-run --precompile uses the same hints).
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../includes/analyze.h"
+#include "../includes/rom.h"
+
+static void usage()
+{
+    fprintf(stderr,
+            "usage: chip8-analyze [options] <rom.ch8 | directory>...\n"
+            "  --quirks P   instruction behaviour: default, cosmac-vip, chip-48, super-chip or xo-chip\n");
+}
+
+int main(int argc, char **argv)
+{
+    QuirkProfile quirks = QUIRKS_DEFAULT;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--quirks") == 0)
+        {
+            if (value == nullptr || !parseQuirkProfile(value, quirks))
+            {
+                fprintf(stderr, "chip8-analyze: --quirks needs one of default, cosmac-vip, chip-48, super-chip, xo-chip\n");
+                return 2;
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            usage();
+            return 0;
+        }
+        else if (arg[0] == '-')
+        {
+            fprintf(stderr, "chip8-analyze: unexpected argument %s\n", arg);
+            usage();
+            return 2;
+        }
+        else if (std::filesystem::is_directory(arg))
+        {
+            std::vector<std::string> found;
+            for (const auto &entry : std::filesystem::directory_iterator(arg))
+            {
+                if (entry.is_regular_file())
+                {
+                    found.push_back(entry.path().string());
+                }
+            }
+            std::sort(found.begin(), found.end());
+            paths.insert(paths.end(), found.begin(), found.end());
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty())
+    {
+        usage();
+        return 2;
+    }
+
+    RomLibrary library;
+    int status = 0;
+    for (const std::string &path : paths)
+    {
+        std::string error;
+        std::shared_ptr<const RomImage> rom = library.open(path, error);
+        if (!rom)
+        {
+            fprintf(stderr, "chip8-analyze: %s\n", error.c_str());
+            status = 1;
+            continue;
+        }
+        RomAnalysis analysis = analyzeROM(rom->data(), rom->size(), quirks);
+        printf("%s\n", formatAnalysis(analysis, rom->getName()).c_str());
+    }
+    return status;
+}
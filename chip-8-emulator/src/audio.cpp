@@ -0,0 +1,117 @@
+#include "../includes/audio.h"
+#include "../includes/chip8.h"
+#include <cmath>
+
+namespace
+{
+    const int16_t AMPLITUDE = 8192; // a quarter of full scale, loud enough without clipping anything mixed in
+    const uint64_t PATTERN_BITS = 128;
+
+    // the square wave non-XO-CHIP profiles beep with: 4 bits on, 4 off, 500 Hz at the default pitch
+    const std::array<uint8_t, 16> BEEP_PATTERN = {0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0,
+                                                  0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0};
+    const uint8_t BEEP_PITCH = 64;
+
+    // pattern bits per sample at an XO-CHIP pitch, 32.32 fixed point
+    uint64_t patternStep(uint8_t pitch, uint32_t sampleRate)
+    {
+        return (uint64_t)std::llround(4000.0 * std::exp2((pitch - 64) / 48.0) / sampleRate * 4294967296.0);
+    }
+}
+
+AudioSynth::AudioSynth(uint32_t sampleRate, size_t bufferSamples) : ring(bufferSamples), sampleRate(sampleRate ? sampleRate : 48000)
+{
+}
+
+void AudioSynth::setSampleRate(uint32_t hz)
+{
+    if (hz == 0)
+    {
+        return;
+    }
+    sampleRate = hz;
+    cycleFraction = 0;
+    step = patternStep(pitch, sampleRate);
+}
+
+void AudioSynth::attach(Chip8 &chip8)
+{
+    lastCycle = chip8.getCycleCount();
+    cycleFraction = 0;
+    latch(chip8);
+    // render the tone as it was up to each change, then switch to the new one
+    chip8.setSoundListener([this](const Chip8 &changed, uint64_t cycle) { renderTo(changed, cycle); });
+}
+
+void AudioSynth::update(const Chip8 &chip8)
+{
+    renderTo(chip8, chip8.getCycleCount());
+}
+
+void AudioSynth::renderTo(const Chip8 &chip8, uint64_t cycle)
+{
+    if (cycle < lastCycle)
+    {
+        // reset, a state load or a rewind took the chip back in time, carry on from there in silence
+        lastCycle = cycle;
+        cycleFraction = 0;
+        latch(chip8);
+        return;
+    }
+    uint32_t clockSpeed = chip8.getClockSpeed();
+    uint64_t total = (cycle - lastCycle) * sampleRate + cycleFraction % clockSpeed;
+    lastCycle = cycle;
+    cycleFraction = total % clockSpeed;
+    render(total / clockSpeed);
+    latch(chip8);
+}
+
+size_t AudioSynth::read(int16_t *out, size_t count)
+{
+    return ring.pop(out, count);
+}
+
+void AudioSynth::latch(const Chip8 &chip8)
+{
+    sounding = chip8.getSoundTimer() > 0;
+    bool xo = chip8.getQuirks() == QUIRKS_XO_CHIP;
+    pattern = xo ? chip8.getAudioPattern() : BEEP_PATTERN;
+    uint8_t wanted = xo ? chip8.getPitch() : BEEP_PITCH;
+    if (wanted != pitch || step == 0)
+    {
+        pitch = wanted;
+        step = patternStep(pitch, sampleRate);
+    }
+}
+
+void AudioSynth::render(uint64_t count)
+{
+    // what can't fit is dropped anyway, don't synthesize it (a long headless run can be hours of sound)
+    uint64_t room = ring.capacity() - ring.size();
+    if (count > room)
+    {
+        dropped.fetch_add(count - room, std::memory_order_relaxed);
+        count = room;
+    }
+    while (count > 0)
+    {
+        size_t length = count < chunk.size() ? count : chunk.size();
+        if (!sounding)
+        {
+            chunk.fill(0);
+            position = 0; // the next tone starts at the top of its pattern
+        }
+        else
+        {
+            for (size_t i = 0; i < length; i++)
+            {
+                uint64_t bit = position >> 32;
+                chunk[i] = (pattern[bit >> 3] >> (7 - (bit & 7))) & 1 ? AMPLITUDE : -AMPLITUDE;
+                position = (position + step) % (PATTERN_BITS << 32);
+            }
+        }
+        size_t stored = ring.push(chunk.data(), length);
+        dropped.fetch_add(length - stored, std::memory_order_relaxed);
+        count -= length;
+    }
+}
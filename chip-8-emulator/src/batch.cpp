@@ -0,0 +1,197 @@
+#include "../includes/batch.h"
+#include "../includes/chip8.h"
+#include "../includes/rom.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+const char *haltReasonName(HaltReason reason)
+{
+    switch (reason)
+    {
+    case HALT_BUDGET:
+        return "budget";
+    case HALT_SPIN:
+        return "spin";
+    case HALT_KEY_WAIT:
+        return "key_wait";
+    case HALT_BAD_ROM:
+        return "bad_rom";
+    }
+    return "unknown";
+}
+
+namespace
+{
+    // a job that may be part way through, owned by whichever worker runs its next slice
+    struct Instance {
+        std::unique_ptr<Chip8> chip8; // created on the first slice, freed as soon as the job halts
+        size_t nextKey = 0;           // first key event not yet applied
+    };
+
+    // one worker's jobs. The owner takes from the back so it keeps running the job it just
+    // sliced, thieves take from the front where the jobs nobody has started yet are.
+    struct WorkQueue {
+        std::mutex lock;
+        std::deque<size_t> jobs;
+
+        void push(size_t job)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            jobs.push_back(job);
+        }
+
+        bool pop(size_t &job)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (jobs.empty())
+            {
+                return false;
+            }
+            job = jobs.back();
+            jobs.pop_back();
+            return true;
+        }
+
+        bool steal(size_t &job)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (jobs.empty())
+            {
+                return false;
+            }
+            job = jobs.front();
+            jobs.pop_front();
+            return true;
+        }
+    };
+
+    bool spinning(const Chip8 &chip8)
+    {
+        const std::vector<uint8_t> &memory = chip8.getMemory();
+        uint16_t PC = chip8.getPC() & 0x0FFF;
+        uint16_t opcode = (memory[PC] << 8) | memory[(PC + 1) & 0x0FFF];
+        return opcode == (0x1000 | PC);
+    }
+
+    // runs one time slice of a job, returns true once it has halted and result is filled in
+    bool runSlice(const BatchJob &job, Instance &instance, uint32_t sliceCycles, BatchResult &result)
+    {
+        if (!instance.chip8)
+        {
+            if (!job.rom || job.rom->size() > quirkMemorySize(job.quirks) - 0x200)
+            {
+                result.halt = HALT_BAD_ROM;
+                return true;
+            }
+            instance.chip8.reset(new Chip8());
+            instance.chip8->setClockSpeed(job.clockSpeed);
+            instance.chip8->setSeed(job.seed);
+            instance.chip8->setQuirks(job.quirks);
+            instance.chip8->loadROM(job.rom->data(), job.rom->size());
+        }
+        Chip8 &chip8 = *instance.chip8;
+
+        uint64_t now = chip8.getCycleCount();
+        uint64_t sliceEnd = std::min<uint64_t>(job.cycles, now + sliceCycles);
+        bool halted = now >= job.cycles;
+        result.halt = HALT_BUDGET;
+        while (!halted && now < sliceEnd)
+        {
+            while (instance.nextKey < job.keys.size() && job.keys[instance.nextKey].cycle <= now)
+            {
+                const KeyEvent &event = job.keys[instance.nextKey++];
+                chip8.setKeyState(event.key, event.state);
+            }
+            uint64_t until = sliceEnd;
+            if (instance.nextKey < job.keys.size())
+            {
+                until = std::min(until, job.keys[instance.nextKey].cycle);
+            }
+            chip8.runCycles(until - now); // a key wait idles out the rest of the run
+            now = chip8.getCycleCount();
+
+            if (spinning(chip8))
+            {
+                result.halt = HALT_SPIN;
+                halted = true;
+            }
+            else if (chip8.isWaitingForKey() && instance.nextKey == job.keys.size())
+            {
+                result.halt = HALT_KEY_WAIT;
+                halted = true;
+            }
+        }
+        if (!halted && now < job.cycles)
+        {
+            return false;
+        }
+        result.framebufferHash = chip8.getDisplayHash();
+        result.cycles = now;
+        instance.chip8.reset();
+        return true;
+    }
+}
+
+BatchRunner::BatchRunner(unsigned threads)
+{
+    threadCount = threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency());
+}
+
+std::vector<BatchResult> BatchRunner::run(const std::vector<BatchJob> &jobs)
+{
+    std::vector<BatchResult> results(jobs.size());
+    std::vector<Instance> instances(jobs.size());
+    std::vector<WorkQueue> queues(threadCount);
+    for (size_t job = 0; job < jobs.size(); job++)
+    {
+        queues[job % threadCount].jobs.push_back(job);
+    }
+    std::atomic<size_t> remaining(jobs.size());
+    std::mutex idleLock; // for idle workers to sleep on until the last job halts
+    std::condition_variable allDone;
+
+    auto work = [&](unsigned self) {
+        size_t job;
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            bool found = queues[self].pop(job);
+            for (unsigned i = 1; !found && i < threadCount; i++)
+            {
+                found = queues[(self + i) % threadCount].steal(job);
+            }
+            if (!found)
+            {
+                // everything left is being run by other workers. A sliced job only goes back on its
+                // owner's queue, which takes it straight back, so nothing more turns up to steal
+                std::unique_lock<std::mutex> guard(idleLock);
+                allDone.wait(guard, [&] { return remaining.load(std::memory_order_acquire) == 0; });
+                break;
+            }
+            if (!runSlice(jobs[job], instances[job], sliceCycles, results[job]))
+            {
+                queues[self].push(job);
+            }
+            else if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> guard(idleLock); // a worker between its check and its wait still sees this
+                allDone.notify_all();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned i = 1; i < threadCount; i++)
+    {
+        workers.emplace_back(work, i);
+    }
+    work(0); // the calling thread is worker 0
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    return results;
+}
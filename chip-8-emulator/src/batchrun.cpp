@@ -0,0 +1,157 @@
+// chip8-batch: runs many instances of one or more ROMs in parallel, each with its own pseudo-random
+// key script and CXNN seed, and prints one JSON line per instance with its framebuffer hash, cycle
+// count and why it stopped. A throughput summary goes to stderr.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../includes/batch.h"
+#include "../includes/rom.h"
+
+static void usage()
+{
+    fprintf(stderr,
+            "usage: chip8-batch [options] <rom.ch8 | directory>...\n"
+            "  --instances K  instances per ROM, each with a different key script (default 16)\n"
+            "  --cycles N     instructions per instance (default 1000000)\n"
+            "  --threads N    worker threads (default: one per hardware thread)\n"
+            "  --slice N      instructions per scheduling slice (default 100000)\n");
+}
+
+// a reproducible key script for one instance: random keys tapped at random intervals
+static std::vector<KeyEvent> makeKeyScript(uint64_t seed, uint64_t cycles)
+{
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL + 1;
+    auto next = [&state]() {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+    std::vector<KeyEvent> keys;
+    for (uint64_t cycle = next() % 2000; cycle < cycles; cycle += 200 + next() % 4000)
+    {
+        uint8_t key = next() % 16;
+        keys.push_back({cycle, key, 1});
+        cycle += 20 + next() % 200;
+        keys.push_back({cycle, key, 0});
+    }
+    return keys;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t instancesPerRom = 16;
+    uint64_t cycles = 1000000;
+    unsigned threads = 0;
+    uint32_t slice = 100000;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--instances" || arg == "--cycles" || arg == "--threads" || arg == "--slice")
+        {
+            unsigned long long value = i + 1 < argc ? strtoull(argv[++i], nullptr, 10) : 0;
+            if (value == 0)
+            {
+                fprintf(stderr, "chip8-batch: %s needs a positive number\n", arg.c_str());
+                return 2;
+            }
+            if (arg == "--instances")
+            {
+                instancesPerRom = value;
+            }
+            else if (arg == "--cycles")
+            {
+                cycles = value;
+            }
+            else if (arg == "--threads")
+            {
+                threads = value;
+            }
+            else
+            {
+                slice = value;
+            }
+        }
+        else if (arg[0] == '-')
+        {
+            usage();
+            return arg == "--help" ? 0 : 2;
+        }
+        else if (std::filesystem::is_directory(arg))
+        {
+            std::vector<std::string> found;
+            for (const auto &entry : std::filesystem::directory_iterator(arg))
+            {
+                if (entry.is_regular_file())
+                {
+                    found.push_back(entry.path().string());
+                }
+            }
+            std::sort(found.begin(), found.end());
+            paths.insert(paths.end(), found.begin(), found.end());
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty())
+    {
+        usage();
+        return 2;
+    }
+
+    RomLibrary library; // every instance of a ROM runs from one shared image
+    std::vector<BatchJob> jobs;
+    for (const std::string &path : paths)
+    {
+        std::string error;
+        std::shared_ptr<const RomImage> rom = library.open(path, error);
+        if (!rom)
+        {
+            fprintf(stderr, "chip8-batch: %s\n", error.c_str()); // still queued, reported as bad_rom
+        }
+        for (uint64_t i = 0; i < instancesPerRom; i++)
+        {
+            BatchJob job;
+            job.name = std::filesystem::path(path).filename().string();
+            job.rom = rom;
+            job.keys = makeKeyScript(jobs.size(), cycles);
+            job.seed = jobs.size();
+            job.cycles = cycles;
+            jobs.push_back(std::move(job));
+        }
+    }
+
+    BatchRunner runner(threads);
+    runner.setSliceCycles(slice);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<BatchResult> results = runner.run(jobs);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t totalCycles = 0;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        const BatchResult &result = results[i];
+        totalCycles += result.cycles;
+        // names are plain file names, only quotes and backslashes need escaping
+        std::string name;
+        for (char c : jobs[i].name)
+        {
+            name += (c == '"' || c == '\\') ? std::string("\\") + c : std::string(1, c);
+        }
+        printf("{\"name\": \"%s\", \"instance\": %zu, \"hash\": \"%016llx\", \"cycles\": %llu, \"halt\": \"%s\"}\n",
+               name.c_str(), i, (unsigned long long)result.framebufferHash, (unsigned long long)result.cycles,
+               haltReasonName(result.halt));
+    }
+    fprintf(stderr, "%zu instances on %u threads in %.3f s, %.1f M cycles/s\n", jobs.size(), runner.getThreadCount(),
+            seconds, seconds > 0 ? totalCycles / seconds / 1e6 : 0.0);
+    return 0;
+}
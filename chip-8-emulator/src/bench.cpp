@@ -0,0 +1,224 @@
+// chip8-bench: runs every ROM in a directory headless for a fixed number of cycles with the same
+// scripted key presses, and prints throughput and an instruction mix per ROM as JSON on stdout.
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "../includes/chip8.h"
+#include "../includes/rom.h"
+
+struct RomResult {
+    std::string name;
+    uint64_t instructions = 0;
+    double seconds = 0;
+    uint64_t draws = 0; // DXYN executed
+    std::array<uint64_t, OP_CLASS_COUNT> classes{};
+};
+
+static void usage()
+{
+    fprintf(stderr,
+            "usage: chip8-bench [options] [rom directory]\n"
+            "  --cycles N   instructions per ROM (default 2000000)\n"
+            "  --clock HZ   instructions per second, sets the frame length (default 700)\n"
+            "  --blocks     use the block translator for the timed run\n");
+}
+
+// the same presses for every ROM and every run: each key in turn, held for 3 of every 6 frames
+static void pressScriptedKeys(Chip8 &chip8, uint64_t frame)
+{
+    uint8_t key = (frame / 6) % 16;
+    uint8_t previous = (key + 15) % 16;
+    chip8.setKeyState(previous, 0);
+    chip8.setKeyState(key, frame % 6 < 3);
+}
+
+// runs cycles instructions a frame at a time. With classes set it single steps and tallies every
+// instruction before running it, otherwise it runs full speed through runCycles.
+static void runScripted(Chip8 &chip8, uint64_t cycles, uint32_t frameCycles, RomResult *classes)
+{
+    for (uint64_t frame = 0; cycles > 0; frame++)
+    {
+        pressScriptedKeys(chip8, frame);
+        uint32_t batch = cycles < frameCycles ? (uint32_t)cycles : frameCycles;
+        cycles -= batch;
+        if (classes == nullptr)
+        {
+            chip8.runCycles(batch, 0); // key waits spin like on hardware so they count as work
+            continue;
+        }
+        const std::vector<uint8_t> &memory = chip8.getMemory();
+        for (uint32_t i = 0; i < batch; i++)
+        {
+            uint16_t PC = chip8.getPC();
+            OpKind kind = Chip8::decode((memory[PC & 0x0FFF] << 8) | memory[(PC + 1) & 0x0FFF], quirkExtended(chip8.getQuirks())).kind;
+            classes->classes[opClass(kind)]++;
+            classes->draws += kind == OP_DXYN;
+            chip8.emulateCycle();
+        }
+    }
+}
+
+// ROM file names are free text, escape what JSON needs escaped
+static std::string jsonString(const std::string &text)
+{
+    std::string out = "\"";
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if ((unsigned char)c < 0x20)
+        {
+            char escaped[8];
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            out += escaped;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+    return out + "\"";
+}
+
+static void printResult(const RomResult &result, bool last)
+{
+    double ips = result.seconds > 0 ? result.instructions / result.seconds : 0;
+    double nsPerInstruction = result.instructions > 0 ? result.seconds * 1e9 / result.instructions : 0;
+    double drawsPerSecond = result.seconds > 0 ? result.draws / result.seconds : 0;
+    printf("    {\"name\": %s, \"instructions\": %llu, \"seconds\": %.6f, \"ips\": %.0f, "
+           "\"ns_per_instruction\": %.3f, \"draws\": %llu, \"draws_per_second\": %.0f, \"classes\": {",
+           jsonString(result.name).c_str(), (unsigned long long)result.instructions, result.seconds, ips,
+           nsPerInstruction, (unsigned long long)result.draws, drawsPerSecond);
+    for (int c = 0; c < OP_CLASS_COUNT; c++)
+    {
+        printf("%s\"%s\": %llu", c == 0 ? "" : ", ", opClassName((OpClass)c),
+               (unsigned long long)result.classes[c]);
+    }
+    printf("}}%s\n", last ? "" : ",");
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t cycles = 2000000;
+    uint32_t clock = 700;
+    bool useBlocks = false;
+    std::string directory = "roms";
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        if ((strcmp(arg, "--cycles") == 0 || strcmp(arg, "--clock") == 0) && i + 1 < argc)
+        {
+            unsigned long long value = strtoull(argv[++i], nullptr, 10);
+            if (value == 0)
+            {
+                fprintf(stderr, "chip8-bench: %s needs a positive number\n", arg);
+                return 2;
+            }
+            if (arg[2] == 'c' && arg[3] == 'y')
+            {
+                cycles = value;
+            }
+            else
+            {
+                clock = value;
+            }
+        }
+        else if (strcmp(arg, "--blocks") == 0)
+        {
+            useBlocks = true;
+        }
+        else if (arg[0] == '-')
+        {
+            usage();
+            return strcmp(arg, "--help") == 0 ? 0 : 2;
+        }
+        else
+        {
+            directory = arg;
+        }
+    }
+
+    std::vector<std::string> paths;
+    std::error_code error;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.is_regular_file())
+        {
+            paths.push_back(entry.path().string());
+        }
+    }
+    if (error || paths.empty())
+    {
+        fprintf(stderr, "chip8-bench: no ROMs found in %s\n", directory.c_str());
+        return 1;
+    }
+    std::sort(paths.begin(), paths.end());
+
+    uint32_t frameCycles = std::max<uint32_t>(clock / 60, 1);
+    std::vector<RomResult> results;
+    static Chip8 chip8; // large, keep it off the stack
+    for (const std::string &path : paths)
+    {
+        std::vector<uint8_t> rom;
+        std::string reason;
+        if (!readROMFile(path, rom, reason))
+        {
+            fprintf(stderr, "chip8-bench: skipping %s\n", reason.c_str());
+            continue;
+        }
+        RomResult result;
+        result.name = std::filesystem::path(path).filename().string();
+        result.instructions = cycles;
+
+        // timed run first, at full speed and with nothing else going on
+        chip8.setSeed(1);
+        chip8.reset();
+        chip8.setClockSpeed(clock);
+        chip8.setBlockTranslation(useBlocks);
+        chip8.loadROM(rom.data(), rom.size());
+        auto start = std::chrono::steady_clock::now();
+        runScripted(chip8, cycles, frameCycles, nullptr);
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        // then the same run again, single stepped, to count what it executed
+        chip8.reset();
+        chip8.setBlockTranslation(false);
+        chip8.loadROM(rom.data(), rom.size());
+        runScripted(chip8, cycles, frameCycles, &result);
+        results.push_back(result);
+    }
+
+    RomResult total;
+    total.name = "total";
+    for (const RomResult &result : results)
+    {
+        total.instructions += result.instructions;
+        total.seconds += result.seconds;
+        total.draws += result.draws;
+        for (int c = 0; c < OP_CLASS_COUNT; c++)
+        {
+            total.classes[c] += result.classes[c];
+        }
+    }
+
+    printf("{\n  \"cycles_per_rom\": %llu,\n  \"clock_hz\": %u,\n  \"block_translation\": %s,\n  \"roms\": [\n",
+           (unsigned long long)cycles, clock, useBlocks ? "true" : "false");
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        printResult(results[i], i + 1 == results.size());
+    }
+    printf("  ],\n  \"total\":\n");
+    printResult(total, true);
+    printf("}\n");
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include "../includes/blocks.h"
+#include <algorithm>
+
+// instructions kept across all blocks before the cache is flushed and rebuilt from scratch,
+// which also drops the pool space left behind by invalidated blocks
+const size_t POOL_LIMIT = 16384;
+
+bool endsBlock(OpKind kind)
+{
+    switch (kind)
+    {
+    case OP_00E0: // draws
+    case OP_DXYN:
+    case OP_00CN:
+    case OP_00DN:
+    case OP_00FB:
+    case OP_00FC:
+    case OP_00FE:
+    case OP_00FF:
+    case OP_00EE: // jumps, calls and returns
+    case OP_00FD:
+    case OP_1NNN:
+    case OP_2NNN:
+    case OP_BNNN:
+    case OP_3XNN: // skips
+    case OP_4XNN:
+    case OP_5XY0:
+    case OP_9XY0:
+    case OP_EX9E:
+    case OP_EXA1:
+    case OP_FX0A: // key wait
+    case OP_FX33: // stores
+    case OP_FX55:
+    case OP_5XY2:
+    case OP_F000: // four bytes long, the next instruction isn't where the block expects
+    case OP_DECODE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool changesFlow(OpKind kind)
+{
+    switch (kind)
+    {
+    case OP_00EE:
+    case OP_00FD:
+    case OP_1NNN:
+    case OP_2NNN:
+    case OP_BNNN:
+    case OP_3XNN:
+    case OP_4XNN:
+    case OP_5XY0:
+    case OP_9XY0:
+    case OP_EX9E:
+    case OP_EXA1:
+    case OP_F000:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool readsTimers(OpKind kind)
+{
+    return kind == OP_FX07 || kind == OP_FX15 || kind == OP_FX18;
+}
+
+void BlockCache::setEnabled(bool on)
+{
+    enabled = on;
+    clear();
+    if (enabled)
+    {
+        startAt.assign(4096, 0);
+        covered.assign(4096, 0);
+    }
+    else
+    {
+        // give the memory back, a disabled cache costs nothing per instance
+        startAt = std::vector<uint16_t>();
+        covered = std::vector<uint8_t>();
+        blocks.shrink_to_fit();
+        pool.shrink_to_fit();
+    }
+}
+
+const Block &BlockCache::add(uint16_t start, const DecodedOp *ops, uint16_t length, bool idle, bool timed)
+{
+    if (pool.size() + length > POOL_LIMIT)
+    {
+        clear();
+    }
+    Block block;
+    block.start = start & 0x0FFF;
+    block.length = length;
+    block.idle = idle;
+    block.timed = timed;
+    block.end = block.start + length * 2;
+    block.first = pool.size();
+    pool.insert(pool.end(), ops, ops + length);
+    for (uint16_t address = block.start; address < block.end; address++)
+    {
+        covered[address & 0x0FFF]++;
+    }
+    blocks.push_back(block);
+    startAt[block.start] = blocks.size();
+    return blocks.back();
+}
+
+void BlockCache::invalidate(uint16_t address)
+{
+    address &= 0x0FFF;
+    if (covered[address] == 0)
+    {
+        return; // plain data write, the common case
+    }
+    for (Block &block : blocks)
+    {
+        // a block that runs past 0xFFF wraps around, so compare against the unwrapped address too
+        bool contains = (block.start <= address && address < block.end) || (address + 0x1000 < block.end);
+        if (block.length == 0 || !contains)
+        {
+            continue;
+        }
+        for (uint16_t a = block.start; a < block.end; a++)
+        {
+            covered[a & 0x0FFF]--;
+        }
+        startAt[block.start] = 0;
+        block.length = 0; // dead, its pool space is reclaimed at the next flush
+    }
+}
+
+void BlockCache::clear()
+{
+    blocks.clear();
+    pool.clear();
+    std::fill(startAt.begin(), startAt.end(), 0);
+    std::fill(covered.begin(), covered.end(), 0);
+}
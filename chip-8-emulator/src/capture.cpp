@@ -0,0 +1,249 @@
+#include "../includes/capture.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    uint64_t tickOf(const Chip8 &chip8)
+    {
+        return chip8.getCycleCount() * 60 / chip8.getClockSpeed();
+    }
+
+    // GIF delays are in hundredths of a second, rounded per tick so they add up without drifting
+    uint64_t centiseconds(uint64_t tick)
+    {
+        return (tick * 100 + 30) / 60;
+    }
+
+    // rows of a plane pair that differ between two frames, bit y for row y
+    uint64_t changedRows(const uint64_t *a, const uint64_t *b)
+    {
+        uint64_t rows = 0;
+        for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+        {
+            for (int y = 0; y < DISPLAY_MAX_HEIGHT; y++)
+            {
+                size_t word = plane * DISPLAY_PLANE_WORDS + y * DISPLAY_ROW_WORDS;
+                bool differs = memcmp(a + word, b + word, DISPLAY_ROW_WORDS * sizeof(uint64_t)) != 0;
+                rows |= uint64_t(differs) << y;
+            }
+        }
+        return rows;
+    }
+}
+
+bool parseCaptureFormat(const char *name, CaptureFormat &format)
+{
+    const char *const names[] = {"gif", "png", "raw"};
+    for (int i = 0; i < 3; i++)
+    {
+        if (strcmp(name, names[i]) == 0)
+        {
+            format = (CaptureFormat)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+FrameCapture::FrameCapture(CaptureFormat format, const std::string &path, int scale, size_t queueFrames)
+    : format(format), path(path), scale(std::min(std::max(scale, 1), Rasterizer::MAX_SCALE / 2)),
+      queue(std::max<size_t>(queueFrames, 1))
+{
+    if (format == CAPTURE_PNG)
+    {
+        std::error_code failure;
+        std::filesystem::create_directories(path, failure);
+        if (failure)
+        {
+            fail("cannot create " + path + ": " + failure.message());
+        }
+    }
+    else if (format == CAPTURE_RAW)
+    {
+        raw = fopen(path.c_str(), "wb");
+        if (raw == nullptr)
+        {
+            fail("cannot write " + path);
+        }
+    }
+    else if (!gif.open(path, DISPLAY_MAX_WIDTH * this->scale, DISPLAY_MAX_HEIGHT * this->scale, rasterizer.getPalette()))
+    {
+        fail("cannot write " + path);
+    }
+    worker = std::thread(&FrameCapture::encodeLoop, this);
+}
+
+FrameCapture::~FrameCapture()
+{
+    if (worker.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            closing = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+    if (raw != nullptr)
+    {
+        fclose(raw);
+    }
+}
+
+void FrameCapture::submit(const Chip8 &chip8)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (count == queue.size())
+        {
+            dropped++; // the encoder is behind, better a missing frame than a stalled machine
+            return;
+        }
+        Frame &frame = queue[(head + count) % queue.size()];
+        // the planes of the front frame are one block, plane after plane
+        memcpy(frame.planes.data(), chip8.getFramePlane(0), sizeof(frame.planes));
+        frame.hires = chip8.getFrameWidth() == DISPLAY_MAX_WIDTH;
+        frame.tick = tickOf(chip8);
+        count++;
+    }
+    wake.notify_one();
+}
+
+bool FrameCapture::finish(const Chip8 &chip8)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closing = true;
+    }
+    wake.notify_one();
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+    if (format == CAPTURE_GIF)
+    {
+        if (pending)
+        {
+            emitGif(std::max(tickOf(chip8), pendingTick + 1));
+        }
+        if (!gif.close() && error.empty())
+        {
+            fail("cannot write " + path);
+        }
+    }
+    else if (raw != nullptr)
+    {
+        if (fclose(raw) != 0)
+        {
+            fail("cannot write " + path);
+        }
+        raw = nullptr;
+    }
+    return error.empty();
+}
+
+void FrameCapture::encodeLoop()
+{
+    Frame frame;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this] { return count > 0 || closing; });
+            if (count == 0)
+            {
+                return; // closing, and everything queued is encoded
+            }
+            frame = queue[head];
+            head = (head + 1) % queue.size();
+            count--;
+        }
+        if (error.empty())
+        {
+            encode(frame);
+        }
+    }
+}
+
+void FrameCapture::encode(const Frame &frame)
+{
+    uint64_t rows = ~0ULL;
+    if (haveLast && frame.hires == last.hires)
+    {
+        rows = changedRows(frame.planes.data(), last.planes.data());
+        if (rows == 0)
+        {
+            duplicates++;
+            return;
+        }
+    }
+    last = frame;
+    haveLast = true;
+    encoded++;
+
+    rasterizer.setScale(frame.hires ? scale : scale * 2);
+    const uint32_t *pixels = rasterizer.render(frame.planes.data(), frame.planes.data() + DISPLAY_PLANE_WORDS, frame.hires, rows);
+    int width = rasterizer.getWidth();
+    int height = rasterizer.getHeight();
+    size_t count = (size_t)width * height;
+
+    if (format == CAPTURE_RAW)
+    {
+        uint8_t header[8] = {uint8_t(frame.tick), uint8_t(frame.tick >> 8), uint8_t(frame.tick >> 16), uint8_t(frame.tick >> 24),
+                             uint8_t(width), uint8_t(width >> 8), uint8_t(height), uint8_t(height >> 8)};
+        if (fwrite(header, 1, sizeof(header), raw) != sizeof(header) || fwrite(pixels, 4, count, raw) != count)
+        {
+            fail("cannot write " + path);
+        }
+        return;
+    }
+    if (format == CAPTURE_PNG)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "frame_%06llu.png", (unsigned long long)frame.tick);
+        std::vector<uint8_t> png = encodePNG(pixels, width, height);
+        std::ofstream file(std::filesystem::path(path) / name, std::ios::binary);
+        file.write((const char *)png.data(), png.size());
+        if (!file)
+        {
+            fail("cannot write " + path + "/" + name);
+        }
+        return;
+    }
+
+    // a GIF frame's delay is only known once the next one arrives. One shown for less than 2/100 s
+    // is replaced by the next instead, most viewers play shorter delays far too slowly.
+    if (pending && centiseconds(frame.tick) - centiseconds(pendingTick) >= 2)
+    {
+        emitGif(frame.tick);
+    }
+    if (!pending)
+    {
+        pendingTick = frame.tick;
+        pending = true;
+    }
+    const uint32_t *palette = rasterizer.getPalette();
+    indices.resize(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t color = pixels[i];
+        indices[i] = color == palette[1] ? 1 : color == palette[2] ? 2 : color == palette[3] ? 3 : 0;
+    }
+}
+
+void FrameCapture::emitGif(uint64_t endTick)
+{
+    gif.addFrame(indices.data(), centiseconds(endTick) - centiseconds(pendingTick));
+    pending = false;
+}
+
+void FrameCapture::fail(const std::string &message)
+{
+    if (error.empty())
+    {
+        error = message;
+    }
+}
@@ -0,0 +1,223 @@
+// chip8-capture: runs ROMs headless and records every frame they publish, as an animated GIF, a
+// directory of PNGs or raw RGBA video, for checking rendering in CI without a browser. Several
+// ROMs are captured in parallel, one per thread, each encoding on a thread of its own.
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../includes/capture.h"
+#include "../includes/rom.h"
+
+static void usage()
+{
+    fprintf(stderr,
+            "usage: chip8-capture [options] <rom.ch8 | directory>...\n"
+            "  --format F   gif (default), png (a directory of frames per ROM) or raw (RGBA video)\n"
+            "  --out DIR    where to write the captures (default capture)\n"
+            "  --frames N   frames of 1/60 s to run each ROM for (default 600)\n"
+            "  --scale N    output pixels per high resolution pixel (default 2)\n"
+            "  --clock HZ   instructions per second (default 700)\n"
+            "  --quirks P   instruction behaviour: default, cosmac-vip, chip-48, super-chip or xo-chip\n"
+            "  --threads N  ROMs captured at once (default: one per hardware thread)\n");
+}
+
+// parses a positive integer option value, exits with usage on anything else
+static uint64_t parseCount(const char *option, const char *value)
+{
+    char *end = nullptr;
+    unsigned long long count = value ? strtoull(value, &end, 10) : 0;
+    if (value == nullptr || *value == '\0' || *end != '\0' || count == 0)
+    {
+        fprintf(stderr, "chip8-capture: %s needs a positive number\n", option);
+        usage();
+        exit(2);
+    }
+    return count;
+}
+
+struct CaptureSettings {
+    CaptureFormat format = CAPTURE_GIF;
+    std::filesystem::path out = "capture";
+    uint64_t frames = 600;
+    int scale = 2;
+    uint32_t clock = 700;
+    QuirkProfile quirks = QUIRKS_DEFAULT;
+};
+
+// runs one ROM with no keys pressed and captures it, returns the line to report
+static std::string captureROM(const std::string &path, const CaptureSettings &settings, RomLibrary &library, bool &ok)
+{
+    std::string error;
+    std::shared_ptr<const RomImage> rom = library.open(path, error);
+    if (!rom)
+    {
+        ok = false;
+        return error;
+    }
+    const char *const extensions[] = {".gif", "", ".raw"};
+    std::filesystem::path output = settings.out / (std::filesystem::path(path).stem().string() + extensions[settings.format]);
+
+    auto chip8 = std::make_unique<Chip8>(); // large, keep it off the stack
+    FrameCapture capture(settings.format, output.string(), settings.scale);
+    chip8->setClockSpeed(settings.clock);
+    chip8->setQuirks(settings.quirks);
+    chip8->setFrameListener([&capture](const Chip8 &published) { capture.submit(published); });
+    chip8->loadROM(rom->data(), rom->size());
+    capture.submit(*chip8); // the blank screen was published before anyone listened
+
+    uint64_t cycles = settings.frames * settings.clock / 60;
+    while (cycles > 0)
+    {
+        uint32_t batch = cycles > 1000000 ? 1000000 : (uint32_t)cycles;
+        chip8->runCycles(batch);
+        cycles -= batch;
+    }
+    chip8->setFrameListener(nullptr);
+    if (!capture.finish(*chip8))
+    {
+        ok = false;
+        return rom->getName() + ": " + capture.getError();
+    }
+    char summary[160];
+    snprintf(summary, sizeof(summary), "%llu frames, %llu duplicates, %llu dropped",
+             (unsigned long long)capture.getFramesEncoded(), (unsigned long long)capture.getDuplicates(),
+             (unsigned long long)capture.getDropped());
+    ok = true;
+    return output.string() + ": " + summary;
+}
+
+int main(int argc, char **argv)
+{
+    CaptureSettings settings;
+    unsigned threads = 0;
+    std::vector<std::string> paths;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--format") == 0)
+        {
+            if (value == nullptr || !parseCaptureFormat(value, settings.format))
+            {
+                fprintf(stderr, "chip8-capture: --format needs one of gif, png, raw\n");
+                return 2;
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--out") == 0 && value != nullptr)
+        {
+            settings.out = value;
+            i++;
+        }
+        else if (strcmp(arg, "--frames") == 0)
+        {
+            settings.frames = parseCount(arg, value);
+            i++;
+        }
+        else if (strcmp(arg, "--scale") == 0)
+        {
+            settings.scale = (int)std::min<uint64_t>(parseCount(arg, value), Rasterizer::MAX_SCALE / 2);
+            i++;
+        }
+        else if (strcmp(arg, "--clock") == 0)
+        {
+            settings.clock = parseCount(arg, value);
+            i++;
+        }
+        else if (strcmp(arg, "--quirks") == 0)
+        {
+            if (value == nullptr || !parseQuirkProfile(value, settings.quirks))
+            {
+                fprintf(stderr, "chip8-capture: --quirks needs one of default, cosmac-vip, chip-48, super-chip, xo-chip\n");
+                return 2;
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--threads") == 0)
+        {
+            threads = parseCount(arg, value);
+            i++;
+        }
+        else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            usage();
+            return 0;
+        }
+        else if (arg[0] == '-')
+        {
+            fprintf(stderr, "chip8-capture: unexpected argument %s\n", arg);
+            usage();
+            return 2;
+        }
+        else if (std::filesystem::is_directory(arg))
+        {
+            std::vector<std::string> found;
+            for (const auto &entry : std::filesystem::directory_iterator(arg))
+            {
+                if (entry.is_regular_file())
+                {
+                    found.push_back(entry.path().string());
+                }
+            }
+            std::sort(found.begin(), found.end());
+            paths.insert(paths.end(), found.begin(), found.end());
+        }
+        else
+        {
+            paths.push_back(arg);
+        }
+    }
+    if (paths.empty())
+    {
+        usage();
+        return 2;
+    }
+    std::error_code failure;
+    std::filesystem::create_directories(settings.out, failure);
+    if (failure)
+    {
+        fprintf(stderr, "chip8-capture: cannot create %s: %s\n", settings.out.string().c_str(), failure.message().c_str());
+        return 1;
+    }
+
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min<size_t>(threads, paths.size());
+    std::vector<std::string> reports(paths.size());
+    std::vector<char> succeeded(paths.size());
+    RomLibrary library;
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        workers.emplace_back([&] {
+            for (size_t i = next++; i < paths.size(); i = next++)
+            {
+                bool ok = false;
+                reports[i] = captureROM(paths[i], settings, library, ok);
+                succeeded[i] = ok;
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+
+    int status = 0;
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        fprintf(succeeded[i] ? stdout : stderr, "%s%s\n", succeeded[i] ? "" : "chip8-capture: ", reports[i].c_str());
+        status |= !succeeded[i];
+    }
+    return status;
+}
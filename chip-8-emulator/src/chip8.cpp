@@ -1,12 +1,23 @@
 #include "../includes/chip8.h"
+#include "../includes/rom.h"
 #include <fstream>
 #include <vector>
 #include <iomanip>
 #include <algorithm>
-#include <emscripten.h>
 #include <cstdlib>
+#include <cstring>
 
 const uint16_t FONT_START_ADDRESS = 0x50;
+const uint32_t TIMER_HZ = 60; // delay and sound timers count down at 60 Hz in emulated time
+
+// after an instruction of the given kind: if it changed the sound, report the cycle it took effect
+// on, elapsed cycles past cycleCount. Only the loop running the instruction knows how far that is,
+// since cycleCount is brought up to date in batches. Compiled out for every other kind.
+#define CHIP8_SOUND_CHECK(kind, elapsed)   \
+    if (changesSound(kind))                \
+    {                                      \
+        soundChanged(cycleCount + (elapsed)); \
+    }
 const uint8_t chip8_fontset[80] = {
     0xF0, 0x90, 0x90, 0x90, 0xF0, // 0
     0x20, 0x60, 0x20, 0x20, 0x70, // 1
@@ -25,30 +36,69 @@ const uint8_t chip8_fontset[80] = {
     0xF0, 0x80, 0xF0, 0x80, 0xF0, // E
     0xF0, 0x80, 0xF0, 0x80, 0x80  // F
 };
+// SUPER-CHIP 8x10 digits for FX30, with XO-CHIP's A to F
+const uint16_t BIG_FONT_START_ADDRESS = FONT_START_ADDRESS + sizeof(chip8_fontset);
+const uint8_t chip8_big_fontset[160] = {
+    0x3C, 0x7E, 0xE7, 0xC3, 0xC3, 0xC3, 0xC3, 0xE7, 0x7E, 0x3C, // 0
+    0x18, 0x38, 0x58, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, // 1
+    0x3E, 0x7F, 0xC3, 0x06, 0x0C, 0x18, 0x30, 0x60, 0xFF, 0xFF, // 2
+    0x3C, 0x7E, 0xC3, 0x03, 0x0E, 0x0E, 0x03, 0xC3, 0x7E, 0x3C, // 3
+    0x06, 0x0E, 0x1E, 0x36, 0x66, 0xC6, 0xFF, 0xFF, 0x06, 0x06, // 4
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFC, 0xFE, 0x03, 0xC3, 0x7E, 0x3C, // 5
+    0x3E, 0x7C, 0xC0, 0xC0, 0xFC, 0xFE, 0xC3, 0xC3, 0x7E, 0x3C, // 6
+    0xFF, 0xFF, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x60, 0x60, // 7
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7E, 0x7E, 0xC3, 0xC3, 0x7E, 0x3C, // 8
+    0x3C, 0x7E, 0xC3, 0xC3, 0x7F, 0x3F, 0x03, 0x03, 0x3E, 0x7C, // 9
+    0x7E, 0xFF, 0xC3, 0xC3, 0xC3, 0xFF, 0xFF, 0xC3, 0xC3, 0xC3, // A
+    0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, 0xC3, 0xC3, 0xFC, 0xFC, // B
+    0x3C, 0xFF, 0xC3, 0xC0, 0xC0, 0xC0, 0xC0, 0xC3, 0xFF, 0x3C, // C
+    0xFC, 0xFE, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xC3, 0xFE, 0xFC, // D
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, // E
+    0xFF, 0xFF, 0xC0, 0xC0, 0xFF, 0xFF, 0xC0, 0xC0, 0xC0, 0xC0  // F
+};
+
+// rotate a display row right by n pixels, pixels pushed off the right edge come back on the left
+static inline uint64_t rotateRight(uint64_t row, unsigned n)
+{
+    n &= 63;
+    return n == 0 ? row : (row >> n) | (row << (64 - n));
+}
 
 Chip8::Chip8()
 {
-    srand(time(0)); // seed the random number generator
-    PC = 0x200;     // programs start at memory address 0x200
-    // Load the fontset into memory
+    PC = 0x200; // programs start at memory address 0x200
+    setSeed(seed); // same default seed every time, hosts that want variety call setSeed
+    resizeMemory();
+    dirtyPages.set();
+    // Load the fontsets into memory
     for (size_t i = 0; i < sizeof(chip8_fontset); i++)
     {
         memory[FONT_START_ADDRESS + i] = chip8_fontset[i];
     }
+    for (size_t i = 0; i < sizeof(chip8_big_fontset); i++)
+    {
+        memory[BIG_FONT_START_ADDRESS + i] = chip8_big_fontset[i];
+    }
 }
 
 void Chip8::reset()
 {
     // Reset the program counter to the start location of most programs
     PC = 0x200;
-    // Clear memory
-    memory.fill(0);
+    // Clear memory and everything decoded from it
+    std::fill(memory.begin(), memory.end(), 0);
+    dirtyPages.set();
+    decodeCache.fill(DecodedOp{});
+    blocks.clear();
     // Clear the registers
     V.fill(0);
     // Reset index
     I = 0;
-    // Clear the display
+    // Clear the display, back in low resolution on the first plane, and make sure the host redraws all of it
     display.fill(0);
+    hires = false;
+    planes = 1;
+    dirtyRows = ~0ULL;
     // Reset the stack pointer
     SP = 0;
     // clear the stack
@@ -56,616 +106,1549 @@ void Chip8::reset()
     // reset timers
     delayTimer = 0;
     soundTimer = 0;
-    // reset keys
+    // reset keys, RPL flags and sound
     keys.fill(0);
-    // Reload the fontset after clearing memory
+    flags.fill(0);
+    audioPattern.fill(0);
+    pitch = 64;
+    // rewind emulated time and clear batch state
+    timerPhase = 0;
+    cycleCount = 0;
+    cycleFraction = 0;
+    waitingForKey = false;
+    drawn = false;
+    // restart the random sequence, so a reset machine replays exactly like a new one
+    setSeed(seed);
+    PROFILE_CALLS(); // back at the top level
+    // Reload the fontsets after clearing memory
     for (size_t i = 0; i < sizeof(chip8_fontset); i++)
     {
         memory[FONT_START_ADDRESS + i] = chip8_fontset[i];
     }
+    for (size_t i = 0; i < sizeof(chip8_big_fontset); i++)
+    {
+        memory[BIG_FONT_START_ADDRESS + i] = chip8_big_fontset[i];
+    }
+    present(); // the blank screen, without waiting for the first tick
     // Log the reset action
-    EM_ASM({ appendLog("Chip-8 state has been reset"); });
+    TRACE_EVENT("Chip-8 state has been reset");
 }
 
 void Chip8::setKeyState(uint8_t key, uint8_t state)
 {
     if (keys[key] != state)
     {
-        EM_ASM({ appendLog("Key Press Detected: Key " + $0 + " set to " + $1.toString()); }, key, state);
+        TRACE_INSTR("Key Press Detected: Key %d set to %d", key, state);
     }
     keys[key] = state; // set the state of the key
 }
 
 void Chip8::loadROM(const uint8_t *romData, size_t size)
 {
-    if (size > 3584)
+    if (size > getMemorySize() - 0x200)
     {
-        EM_ASM({appendLog("ERROR: ROM is too large!!");});
+        TRACE_EVENT("ERROR: ROM is too large for the %s quirk profile!!", quirkProfileName(quirks));
         return;
     }
 
-    for (size_t i = 0; i < size; i++)
-    {
-        memory[0x200 + i] = romData[i]; // Load ROM into memory starting at 0x200
-    }
+    std::copy_n(romData, size, memory.begin() + 0x200); // Load ROM into memory starting at 0x200, in one go
+    dirtyPages.set();
+    decodeCache.fill(DecodedOp{}); // everything cached so far may have been overwritten
+    blocks.clear();
     // Log successful load, passing size as an argument.
-    EM_ASM_({ appendLog("Loaded ROM successfully (" + $0.toString() + " bytes)"); }, size);
+    TRACE_EVENT("Loaded ROM successfully (%zu bytes)", size);
 }
 
 void Chip8::emulateCycle()
 {
-    uint16_t opcode = (memory[PC] << 8) | memory[PC + 1];
-    // Log fetched opcode. We convert the opcode to hex in JS.
-    EM_ASM_({var hexOpcode = ("0000" + $0.toString(16)).slice(-4);appendLog("Fetched opcode: 0x" + hexOpcode); }, opcode);
+    // fetch the already decoded instruction at PC (copied, since it may overwrite itself)
+    DecodedOp op = decodeCache[PC & 0x0FFF];
+    TRACE_INSTR("Fetched opcode: 0x%04x", (memory[PC & 0x0FFF] << 8) | memory[(PC + 1) & 0x0FFF]);
+    PROFILE_INSTR(op.kind);
 
-    executeOpcode(opcode);
+    uint16_t address = PC & 0x0FFF;
+    execute(op);
+    CHIP8_SOUND_CHECK(decodeCache[address].kind, 1); // decoded by now, if it wasn't yet
+    advanceTime(1);
+}
 
-    if (delayTimer > 0)
+inline void Chip8::advanceTime(uint32_t cycles)
+{
+    cycleCount += cycles;
+    // every cycle adds TIMER_HZ to the phase and every clockSpeed of phase is one timer tick,
+    // so ticks land exactly 60 times per emulated second at any clock speed without drifting
+    uint64_t phase = timerPhase + (uint64_t)cycles * TIMER_HZ;
+    if (phase < clockSpeed)
     {
-        delayTimer--;
+        timerPhase = phase; // common case: no tick this cycle
+        return;
     }
+    tickTimers(phase);
+}
 
+void Chip8::tickTimers(uint64_t phase)
+{
+    uint64_t ticks = phase / clockSpeed;
+    timerPhase = phase % clockSpeed;
+    delayTimer = ticks >= delayTimer ? 0 : delayTimer - ticks;
     if (soundTimer > 0)
     {
-        soundTimer--;
+        uint8_t left = soundTimer;
+        soundTimer = ticks >= soundTimer ? 0 : soundTimer - ticks;
+        if (soundTimer == 0)
+        {
+            // the tone stopped on tick number left of these, which may be a few ticks back
+            uint64_t since = (timerPhase + (ticks - left) * clockSpeed) / TIMER_HZ;
+            soundChanged(cycleCount - std::min(since, cycleCount));
+        }
     }
+    present(); // vertical blank
 }
 
-void Chip8::executeOpcode(uint16_t opcode)
+void Chip8::setClockSpeed(uint32_t hz)
 {
-    switch (opcode & 0xF000)
-    {            // Extracts the first hex nibble (for switch case)
-    case 0x0000: // 0 instructions
-        if (opcode == 0x00E0)
+    if (hz == 0)
+    {
+        TRACE_EVENT("ERROR: Clock speed must be above 0 Hz");
+        return;
+    }
+    timerPhase = (uint64_t)timerPhase * hz / clockSpeed; // keep the same fraction of the current timer period
+    clockSpeed = hz;
+    cycleFraction = 0;
+}
+
+uint32_t Chip8::runCycles(uint32_t count, uint8_t stopMask)
+{
+    drawn = false;
+    bool stopOnKey = stopMask & STOP_ON_KEY_WAIT;
+    bool stopOnDraw = stopMask & STOP_ON_DRAW;
+    uint32_t executed = 0;
+    while (executed < count)
+    {
+        uint32_t ran = 0;
+        if (blocks.isEnabled())
         {
-            display.fill(0); // Set all pixels to 0 (off)
-            EM_ASM({appendLog("Executed: Clear Screen (0x00E0)");});
-        }
-        else if (opcode == 0x00EE)
-        { // 0x00EE - return from subroutine
-            if (SP == 0)
+            // keeps time itself, block by block
+            switch (quirks)
             {
-                //EM_ASM({appendLog("ERROR: Stack underflow on 0x00EE!!!")});
-                return;
+#define CHIP8_CASE(profile)                                                                 \
+    case QUIRKS_##profile:                                                                  \
+        ran = runBlocks<QUIRKS_##profile>(count - executed, stopOnKey, stopOnDraw); \
+        break;
+                CHIP8_QUIRK_PROFILES(CHIP8_CASE)
+#undef CHIP8_CASE
+            default:
+                break;
             }
-            else
+        }
+        else
+        {
+            // the timers only change when they tick, so run straight up to the next tick and account
+            // for the elapsed time once afterwards instead of after every instruction
+            uint32_t untilTick = (clockSpeed - timerPhase + TIMER_HZ - 1) / TIMER_HZ;
+            uint32_t budget = std::min(count - executed, untilTick);
+            switch (quirks)
             {
-                PC = stack[SP - 1]; // move the pointer
-                SP--;               // decrement stack pointer
-                EM_ASM_({var hexAddr = ("000" + $0.toString(16)).slice(-3);
-                appendLog("Executed: Return from subroutine (0x00EE), jumping to 0x" + hexAddr); }, PC);
-                // PC explicity set, exiting early to avoid PC increment
-                return;
+#define CHIP8_CASE(profile)                                                   \
+    case QUIRKS_##profile:                                                    \
+        ran = runSlice<QUIRKS_##profile>(budget, stopOnKey, stopOnDraw); \
+        break;
+                CHIP8_QUIRK_PROFILES(CHIP8_CASE)
+#undef CHIP8_CASE
+            default:
+                break;
             }
+            advanceTime(ran);
         }
-        PC += 2;
-        break;
-    case 0x1000:
-    { // 0x1NNN - Set the program counter to NNN (Jump)
-        uint16_t NNN = opcode & 0x0FFF;
-        PC = NNN;
-        EM_ASM_({
-                var hexAddr = ("000" + $0.toString(16)).slice(-3);
-                appendLog("Executed: Jump to address 0x" + hexAddr); }, NNN);
-    }
-    break;
-    case 0x2000:
-    {                                   // 0x2NNN - Call subroutine at NNN
-        uint16_t NNN = opcode & 0x0FFF; // extract NNN from opcode
-        if (SP >= stack.size())
+        executed += ran;
+        if (stopOnKey && waitingForKey)
         {
-            //EM_ASM({appendLog("ERROR: Stack overflow on 0x2NNN!!!")});
+            // the rest of the batch would only retry FX0A, since keys can't change before we
+            // return. Let that time pass without executing it so the timers keep counting down.
+            PROFILE_IDLE(OP_FX0A, count - executed);
+            PROFILE_KEY_WAIT(count - executed);
+            advanceTime(count - executed);
+            return count;
         }
-        else
+        if (stopOnDraw && drawn)
         {
-            stack[SP] = PC + 2; // push return address to the stack
-            SP++;               // increment stack pointer
-            PC = NNN;           // set the PC to NNN to jump to the subroutine
-            EM_ASM_({var hexAddr = ("000" + $0.toString(16)).slice(-3);
-            appendLog("Executed: Call subroutine at 0x" + hexAddr); }, NNN);
-            break;
+            break; // let the host present the frame
         }
-        return; // return early since PC is explictly set
     }
-    case 0x3000:
-    {                                       // 0x3XNN - Skip next instruction if V[X] == NN
-        uint8_t X = (opcode & 0x0F00) >> 8; // extract X
-        uint8_t NN = opcode & 0x00FF;       // extract NN
+    return executed;
+}
+
+template <QuirkProfile P>
+uint32_t Chip8::runSlice(uint32_t budget, bool stopOnKey, bool stopOnDraw)
+{
+    uint32_t executed = 0;
+    if (budget == 0)
+    {
+        return 0;
+    }
+#if defined(__GNUC__)
+    // threaded dispatch: each handler jumps straight to the next instruction's handler through this
+    // table rather than returning to one shared switch, so every jump is predicted separately and
+    // the handlers are inlined into the loop
+    static void *const labels[OP_KIND_COUNT] = {
+        &&decode_op,
+#define CHIP8_LABEL(name) &&op_##name,
+        CHIP8_OPCODES(CHIP8_LABEL)
+#undef CHIP8_LABEL
+        &&unknown_op,
+    };
+    DecodedOp op;
+
+#define CHIP8_FETCH()                                                                                    \
+    op = decodeCache[PC & 0x0FFF];                                                                       \
+    TRACE_INSTR("Fetched opcode: 0x%04x", (memory[PC & 0x0FFF] << 8) | memory[(PC + 1) & 0x0FFF]); \
+    PROFILE_INSTR(op.kind);                                                                              \
+    executed++;                                                                                          \
+    goto *labels[op.kind]
+#define CHIP8_NEXT()                                                                         \
+    if ((executed == budget) | (stopOnKey & waitingForKey) | (stopOnDraw & drawn)) \
+    {                                                                                        \
+        return executed;                                                                     \
+    }                                                                                        \
+    CHIP8_FETCH()
+
+    CHIP8_FETCH();
+decode_op:
+{
+    uint16_t address = PC & 0x0FFF;
+    opDecode<P>(op);
+    CHIP8_SOUND_CHECK(decodeCache[address].kind, executed);
+}
+    CHIP8_NEXT();
+#define CHIP8_HANDLER(name)                   \
+    op_##name:                                \
+    op##name<P>(op);                          \
+    CHIP8_SOUND_CHECK(OP_##name, executed); \
+    CHIP8_NEXT();
+    CHIP8_OPCODES(CHIP8_HANDLER)
+#undef CHIP8_HANDLER
+unknown_op:
+    opUnknown(op);
+    CHIP8_NEXT();
+#undef CHIP8_NEXT
+#undef CHIP8_FETCH
+#else
+    do
+    {
+        DecodedOp op = decodeCache[PC & 0x0FFF];
+        TRACE_INSTR("Fetched opcode: 0x%04x", (memory[PC & 0x0FFF] << 8) | memory[(PC + 1) & 0x0FFF]);
+        PROFILE_INSTR(op.kind);
+        uint16_t address = PC & 0x0FFF;
+        executeWith<P>(op);
+        executed++;
+        CHIP8_SOUND_CHECK(decodeCache[address].kind, executed);
+    } while (executed < budget && !(stopOnKey && waitingForKey) && !(stopOnDraw && drawn));
+    return executed;
+#endif
+}
+
+void Chip8::setSeed(uint64_t value)
+{
+    seed = value;
+    // splitmix64 spreads similar seeds (0, 1, 2, ...) far apart and never leaves the
+    // xorshift state at zero, where it would get stuck
+    uint64_t z = value + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    rngState = z != 0 ? z : 0x9E3779B97F4A7C15ULL;
+}
+
+inline uint8_t Chip8::nextRandom()
+{
+    // xorshift64*, the top byte of the scrambled output is the best distributed
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (rngState * 0x2545F4914F6CDD1DULL) >> 56;
+}
 
-        if (V[X] == NN)
+void Chip8::setQuirks(QuirkProfile profile)
+{
+    if (profile >= QUIRK_PROFILE_COUNT)
+    {
+        TRACE_EVENT("ERROR: unknown quirk profile %u", profile);
+        return;
+    }
+    QuirkProfile previous = quirks;
+    quirks = profile;
+    quirksChanged(previous);
+}
+
+void Chip8::quirksChanged(QuirkProfile previous)
+{
+    resizeMemory();
+    // everything else decoded and translated stays valid, only the instruction set can change
+    if (quirkExtended(quirks) != quirkExtended(previous))
+    {
+        decodeCache.fill(DecodedOp{});
+        blocks.clear();
+    }
+}
+
+void Chip8::resizeMemory()
+{
+    size_t size = quirkMemorySize(quirks);
+    if (size == memory.size())
+    {
+        return;
+    }
+    // code only runs from the first 4 KB, which every profile has, so nothing decoded is lost
+    memory.resize(size, 0);
+    memory.shrink_to_fit(); // leaving XO-CHIP gives the 60 KB back
+    dirtyPages.set();
+}
+
+void Chip8::setBlockTranslation(bool enabled)
+{
+    blocks.setEnabled(enabled);
+}
+
+size_t Chip8::precompile(const std::vector<uint16_t> &starts)
+{
+    size_t translated = 0;
+    for (uint16_t start : starts)
+    {
+        // the straight-line run from start, as the interpreter would decode it on first use
+        uint16_t address = start & 0x0FFF;
+        for (size_t steps = 0; steps < CODE_SIZE / 2; steps++)
+        {
+            if (decodeCache[address].kind == OP_DECODE)
+            {
+                decodeCache[address] = decode((memory[address] << 8) | memory[(address + 1) & 0x0FFF], quirkExtended(quirks));
+            }
+            if (changesFlow(decodeCache[address].kind))
+            {
+                break;
+            }
+            address = (address + 2) & 0x0FFF;
+        }
+        if (!blocks.isEnabled())
         {
-            PC += 4; // skip the next instruction (2 bytes for current instruction + 2 for next)
-            EM_ASM_({ appendLog("Executed: Skip next instruction because V" + $0.toString() + " equals 0x" + ($1.toString(16).toUpperCase().padStart(2, "0"))); }, X, NN);
+            continue;
         }
-        else
+        // and the blocks it splits into at draws, stores and timer instructions
+        address = start & 0x0FFF;
+        for (size_t steps = 0; steps < CODE_SIZE / 2 && blocks.find(address) == nullptr; steps++)
         {
-            PC += 2; // otherwise proceed as normal
-            EM_ASM_({ appendLog("Executed: No skip because V" + $0.toString() + " does not equal 0x" + ($1.toString(16).toUpperCase().padStart(2, "0"))); }, X, NN);
+            const Block &block = translateBlock(address);
+            translated++;
+            if (changesFlow(blocks.ops(block)[block.length - 1].kind))
+            {
+                break;
+            }
+            address = block.end & 0x0FFF;
         }
-        break;
     }
-    case 0x4000:
-    { // 0x4XNN - Skip next instruction if V[X] != NN
-        uint8_t X = (opcode & 0x0F00) >> 8;
-        uint8_t NN = opcode & 0x00FF;
+    return translated;
+}
 
-        if (V[X] != NN)
+const Block &Chip8::translateBlock(uint16_t start)
+{
+    // decode forward from start until an instruction that has to end the block
+    std::array<DecodedOp, BlockCache::MAX_LENGTH> ops;
+    uint16_t length = 0;
+    uint16_t address = start;
+    do
+    {
+        DecodedOp op = decode((memory[address & 0x0FFF] << 8) | memory[(address + 1) & 0x0FFF], quirkExtended(quirks));
+        if (length > 0 && readsTimers(op.kind))
         {
-            PC += 4; // skip the next instruction (2 bytes for current and 2 bytes for next)
-            EM_ASM_({ appendLog("Executed: Skip next instruction because V" + $0.toString() + " not equals 0x" + ($1.toString(16).toUpperCase().padStart(2, "0"))); }, X, NN);
+            break; // timer instructions only ever start a block, see runBlocks
         }
-        else
+        ops[length++] = op;
+        address += 2;
+    } while (!endsBlock(ops[length - 1].kind) && length < BlockCache::MAX_LENGTH);
+    // a lone jump to itself can be skipped over, except when every instruction has to be traced
+    bool idle = length == 1 && ops[0].kind == OP_1NNN && ops[0].NNN == start && CHIP8_TRACE_LEVEL < CHIP8_TRACE_INSTR;
+    return blocks.add(start, ops.data(), length, idle, readsTimers(ops[0].kind));
+}
+
+template <QuirkProfile P>
+uint32_t Chip8::runBlocks(uint32_t budget, bool stopOnKey, bool stopOnDraw)
+{
+    uint32_t executed = 0;
+    uint32_t settled = 0; // cycles already passed on to advanceTime
+    const Block *block = nullptr;
+    const DecodedOp *ops = nullptr; // next instruction of the current block
+    const DecodedOp *end = nullptr;
+    uint16_t length = 0;
+    // only the last instruction of a block can jump, draw or wait for a key, so nothing needs
+    // checking until the whole block has run. Only the first can touch a timer, so the timers
+    // are brought up to date just before such a block and on the way out, not after every block.
+#if defined(__GNUC__)
+    // same threaded dispatch as runSlice, except the next instruction comes straight from the
+    // current block. Moving on to the next block is repeated at the end of every handler too,
+    // so the jump into a block is predicted from the handler that ended the previous one.
+    static void *const labels[OP_KIND_COUNT] = {
+        &&decode_op,
+#define CHIP8_LABEL(name) &&op_##name,
+        CHIP8_OPCODES(CHIP8_LABEL)
+#undef CHIP8_LABEL
+        &&unknown_op,
+    };
+    DecodedOp op;
+
+#define CHIP8_DISPATCH()                                                                                  \
+    TRACE_INSTR("Fetched opcode: 0x%04x", (memory[PC & 0x0FFF] << 8) | memory[(PC + 1) & 0x0FFF]); \
+    op = *ops++;                                                                                          \
+    PROFILE_INSTR(op.kind);                                                                               \
+    goto *labels[op.kind]
+#define CHIP8_NEXT()                                                                      \
+    if (ops != end)                                                                       \
+    {                                                                                     \
+        CHIP8_DISPATCH();                                                                 \
+    }                                                                                     \
+    executed += length;                                                                   \
+    if ((executed == budget) | (stopOnKey & waitingForKey) | (stopOnDraw & drawn))        \
+    {                                                                                     \
+        advanceTime(executed - settled);                                                  \
+        return executed;                                                                  \
+    }                                                                                     \
+    block = blocks.find(PC);                                                              \
+    if (block == nullptr || block->length > budget - executed || block->idle | block->timed) \
+    {                                                                                     \
+        goto enter_block;                                                                 \
+    }                                                                                     \
+    length = block->length;                                                               \
+    ops = blocks.ops(*block);                                                             \
+    end = ops + length;                                                                   \
+    CHIP8_DISPATCH()
+
+    block = blocks.find(PC);
+enter_block:
+#endif
+    while (executed < budget)
+    {
+        if (block == nullptr)
         {
-            PC += 2; // proceed as normal
-            EM_ASM_({ appendLog("Executed: No skip because V" + $0.toString() + " equals 0x" + ($1.toString(16).toUpperCase().padStart(2, "0"))); }, X, NN);
+            block = &translateBlock(PC);
         }
-        break;
-    }
-    case 0x5000:
-    {                                       // 0x5XY0 - Skip next instruction if V[X] == V[Y] and opcode ends in 0
-        uint8_t X = (opcode & 0x0F00) >> 8; // extract X
-        uint8_t Y = (opcode & 0x00F0) >> 4; // extract Y
-        uint8_t END = opcode & 0x0000F;
-
-        if ((V[X] == V[Y]) && END == 0)
+        // copy what we need, the block can be invalidated by its own last instruction
+        length = block->length;
+        ops = blocks.ops(*block);
+        end = ops + length;
+        advanceTime(executed - settled);
+        settled = executed;
+        if (length > budget - executed)
         {
-            PC += 4; // skip next instruction (2 bytes for current + 2 for next)
-            EM_ASM_({ appendLog("Executed: Skip because V[" + $0.toString() + "]" + " equals V[" + $1.toString() + "]" + " and opcode ended in " + $2.toString()); }, X, Y, END);
+            // not enough budget left for the whole block, finish the batch an instruction at a time
+            while (executed < budget && !(stopOnKey && waitingForKey) && !(stopOnDraw && drawn))
+            {
+                emulateCycle();
+                executed++;
+            }
+            return executed;
         }
-        else
+        if (block->idle)
         {
-            PC += 2; // proceed as normal
-            EM_ASM_({ appendLog("Executed: No skip because V[" + $0.toString() + "]" + " does not equal V[" + $1.toString() + "]" + " or opcode did not end in " + $2.toString()); }, X, Y, END);
+            // a jump to itself spins until the end of the batch without changing anything
+            // but the timers, so skip straight there
+            PROFILE_IDLE(OP_1NNN, budget - executed);
+            advanceTime(budget - executed);
+            return budget;
         }
-        break;
+#if defined(__GNUC__)
+        CHIP8_DISPATCH();
+    decode_op:
+        opDecode<P>(op);
+        CHIP8_NEXT();
+        // ops has moved past the instruction, which was instruction length - (end - ops) of the block
+#define CHIP8_HANDLER(name)                                                          \
+    op_##name:                                                                       \
+    op##name<P>(op);                                                                 \
+    CHIP8_SOUND_CHECK(OP_##name, executed - settled + length - (end - ops)); \
+    CHIP8_NEXT();
+        CHIP8_OPCODES(CHIP8_HANDLER)
+#undef CHIP8_HANDLER
+    unknown_op:
+        opUnknown(op);
+        CHIP8_NEXT();
+#undef CHIP8_NEXT
+#undef CHIP8_DISPATCH
+#else
+        while (ops != end)
+        {
+            TRACE_INSTR("Fetched opcode: 0x%04x", (memory[PC & 0x0FFF] << 8) | memory[(PC + 1) & 0x0FFF]);
+            PROFILE_INSTR(ops->kind);
+            OpKind kind = ops->kind;
+            executeWith<P>(*ops++);
+            CHIP8_SOUND_CHECK(kind, executed - settled + length - (end - ops));
+        }
+        executed += length;
+        if ((stopOnKey & waitingForKey) | (stopOnDraw & drawn))
+        {
+            break;
+        }
+        block = blocks.find(PC);
+#endif
     }
-    case 0x6000:
-    {                                       // 0x6XNN - Set VX to NN
-        uint8_t X = (opcode & 0x0F00) >> 8; // Extract X
-        uint8_t NN = opcode & 0x00FF;       // Extract NN
-        V[X] = NN;
-        EM_ASM_({ appendLog("Executed: Set V" + $0.toString() + " = 0x" + ($1.toString(16).toUpperCase().padStart(2, "0"))); }, X, NN);
-        PC += 2;
+    advanceTime(executed - settled);
+    return executed;
+}
+
+uint32_t Chip8::runFor(uint32_t microseconds, uint8_t stopMask)
+{
+    // convert the budget to whole cycles and carry the fraction into the next call, so calling
+    // once per animation frame averages out to exactly clockSpeed. Cycles skipped by a draw stop
+    // are dropped rather than carried, otherwise the next frame would start with a catch-up burst.
+    uint64_t scaled = (uint64_t)microseconds * clockSpeed + cycleFraction;
+    cycleFraction = scaled % 1000000;
+    return runCycles(scaled / 1000000, stopMask);
+}
+
+void Chip8::executeOpcode(uint16_t opcode)
+{
+    DecodedOp op = decode(opcode, quirkExtended(quirks));
+    execute(op);
+    CHIP8_SOUND_CHECK(op.kind, 0);
+}
+
+void Chip8::execute(const DecodedOp &op)
+{
+    switch (quirks)
+    {
+#define CHIP8_CASE(profile)     \
+    case QUIRKS_##profile:      \
+        executeWith<QUIRKS_##profile>(op); \
+        break;
+        CHIP8_QUIRK_PROFILES(CHIP8_CASE)
+#undef CHIP8_CASE
+    default:
         break;
     }
-    case 0x7000:
-    {                                       // 0x7XNN - Add NN to VX
-        uint8_t X = (opcode & 0x0F00) >> 8; // Extract X
-        uint8_t NN = opcode & 0x00FF;
-        V[X] += NN; // Add NN to VX (no carry flag modification)
-        EM_ASM_({ appendLog("Executed: V" + $0.toString() + " += 0x" + ($1.toString(16).toUpperCase().padStart(2, "0")) +
-                            " (New V" + $0.toString() + " = 0x" + ($2.toString(16).toUpperCase().padStart(2, "0")) + ")"); }, X, NN, V[X]);
-        PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::executeWith(const DecodedOp &op)
+{
+    switch (op.kind)
+    {
+#define CHIP8_CASE(name) \
+    case OP_##name:      \
+        op##name<P>(op); \
+        break;
+        CHIP8_OPCODES(CHIP8_CASE)
+#undef CHIP8_CASE
+    case OP_DECODE:
+        opDecode<P>(op);
+        break;
+    default:
+        opUnknown(op);
         break;
     }
-    case 0x8000:
+}
+
+template <QuirkProfile P>
+void Chip8::writeMemory(uint16_t address, uint8_t value)
+{
+    address &= Quirks<P>::memoryMask;
+    memory[address] = value;
+    dirtyPages.set(address / MEMORY_PAGE_SIZE);
+    if (address >= CODE_SIZE)
     {
-        switch (opcode & 0x000F) // switching on the 0x8XY_ opcodes (distinguished by last nibble)
-        {
-        case 0x0000: // 0x8XY0 - Set V[X] = V[Y]
+        return; // XO-CHIP data, never executed
+    }
+    // the byte belongs to the instruction starting here and to the one starting just before it,
+    // so both are decoded again the next time they run
+    decodeCache[address].kind = OP_DECODE;
+    decodeCache[(address - 1) & 0x0FFF].kind = OP_DECODE;
+    if (blocks.isEnabled())
+    {
+        blocks.invalidate(address);
+    }
+}
+
+template <QuirkProfile P>
+inline uint16_t Chip8::skippedLength() const
+{
+    if (Quirks<P>::longSkips && memory[(PC + 2) & 0x0FFF] == 0xF0 && memory[(PC + 3) & 0x0FFF] == 0x00)
+    {
+        return 4; // F000 NNNN
+    }
+    return 2;
+}
+
+DecodedOp Chip8::decode(uint16_t opcode, bool extended)
+{
+    DecodedOp op;
+    op.X = (opcode & 0x0F00) >> 8; // extract X
+    op.Y = (opcode & 0x00F0) >> 4; // extract Y
+    op.N = opcode & 0x000F;        // extract N
+    op.NN = opcode & 0x00FF;       // extract NN
+    op.NNN = opcode & 0x0FFF;      // extract NNN (12-bit address)
+    op.kind = OP_UNKNOWN;
+
+    switch (opcode & 0xF000)
+    {            // Extracts the first hex nibble (for switch case)
+    case 0x0000: // 0 instructions
+        if (opcode == 0x00E0)
         {
-            uint8_t X = (opcode & 0x0F00) >> 8; // extract X
-            uint8_t Y = (opcode & 0x00F0) >> 4; // extract Y
-            V[X] = V[Y];                        // setting the value in register Y to register X
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] = V[" + $1.toString() + "] (" + "0x" + $2.toString(16).toUpperCase().padStart(2, "0") + " = " + "0x" + $3.toString(16).toUpperCase().padStart(2, "0") + ")"); }, X, Y, V[X], V[Y]);
-            PC += 2;
-            break;
-        }
-        case 0x0001: // 0x8XY1 - Set V[X] = V[X] | V[Y]
-        {
-            uint8_t X = (opcode & 0x0F00) >> 8; // extract X
-            uint8_t Y = (opcode & 0x00F0) >> 4; // extract Y
-            uint8_t oldVX = V[X];               // store original V[X] for logging
-            V[X] = V[X] | V[Y];                 // perform bitwise OR (combine the bits)
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] |= V[" + $1.toString() +
-                               "] (0x" + $2.toString(16).toUpperCase().padStart(2, "0") +
-                                " |= 0x" + $3.toString(16).toUpperCase().padStart(2, "0") +
-                                " => 0x" + $4.toString(16).toUpperCase().padStart(2, "0") + ")"); }, X, Y, oldVX, V[Y], V[X]);
-            PC += 2;
-            break;
-        }
-        case 0x0002: // 0x8XY2 - Set V[X] = V[X] & V[Y]
-        {
-            uint8_t X = (opcode & 0x0F00) >> 8; // extract X
-            uint8_t Y = (opcode & 0x00F0) >> 4; // extract Y
-            uint8_t oldVX = V[X];
-            V[X] = V[X] & V[Y];
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] &= V[" + $1.toString() +
-                                "] (0x" + $2.toString(16).toUpperCase().padStart(2, "0") +
-                                " &= 0x" + $3.toString(16).toUpperCase().padStart(2, "0") +
-                                " => 0x" + $4.toString(16).toUpperCase().padStart(2, "0") + ")"); }, X, Y, oldVX, V[Y], V[X]);
-            PC += 2;
-            break;
-        }
-        case 0x0003: // 0x8XY3 - Set V[X] = V[X] ^ V[Y]
-        {
-            uint8_t X = (opcode & 0x0F00) >> 8; // extract X
-            uint8_t Y = (opcode & 0x00F0) >> 4; // extract Y
-            uint8_t oldVX = V[X];
-            V[X] = V[X] ^ V[Y];
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] ^= V[" + $1.toString() + "] (0x" +
-                                $2.toString(16).toUpperCase().padStart(2, '0') + " ^= 0x" +
-                                $3.toString(16).toUpperCase().padStart(2, '0') + " => 0x" +
-                                $4.toString(16).toUpperCase().padStart(2, '0') + ")"); }, X, Y, oldVX, V[Y], V[X]);
-            PC += 2;
-            break;
+            op.kind = OP_00E0;
         }
-        case 0x0004: // 0x8XY4 - Perform V[X] = V[X] + V[Y]
+        else if (opcode == 0x00EE)
         {
-            uint8_t X = (opcode & 0x0F00) >> 8; // extract X
-            uint8_t Y = (opcode & 0x00F0) >> 4; // extract Y
-            uint8_t oldVX = V[X];               // store old V[X] for logging
-
-            uint16_t sum = V[X] + V[Y];
-
-            if (sum > 0xFF)
-            {
-                V[0xF] = 0x1; // if sum is over 0xFF (255) we store 1 in the carry flag V[0xF]
-            }
-            else
-            {
-                V[0xF] = 0x0; // else we simply store 0
-            }
-            V[X] = (sum & 0xFF); // store the lower 8 bits in V[X]
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] = V[" + $0.toString() + "] + V[" + $1.toString() +
-                                "] (0x" + $2.toString(16).toUpperCase().padStart(2, "0") +
-                                " + 0x" + $3.toString(16).toUpperCase().padStart(2, "0") +
-                                " = 0x" + $4.toString(16).toUpperCase().padStart(3, "0") +
-                                ", carry=" + $5.toString() +
-                                ") => new V[" + $0.toString() + "] = 0x" +
-                                $6.toString(16).toUpperCase().padStart(2, "0")); }, X, Y, oldVX, V[Y], sum, V[0xF], V[X]);
-            PC += 2;
-            break;
+            op.kind = OP_00EE;
         }
-        case 0x0005: // 0x8XY5 - Perform V[X] = V[X] - V[Y]
+        else if ((opcode & 0xFFF0) == 0x00C0)
         {
-            uint8_t X = (opcode & 0x0F00) >> 8; // extract X
-            uint8_t Y = (opcode & 0x00F0) >> 4; // extract Y
-            uint8_t oldVX = V[X];               // store old V[X] for logging
-
-            if (V[X] >= V[Y]) // if V[X] is >= V[Y] set carry flag (V[F]) to 1 else 0
-            {
-                V[0xF] = 0x1;
-            }
-            else
-            {
-                V[0xF] = 0x0;
-            }
-            V[X] = V[X] - V[Y]; // perform the subtraction
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] -= V[" + $1.toString() +
-                                "] (0x" + $2.toString(16).toUpperCase().padStart(2, '0') +
-                                " - 0x" + $3.toString(16).toUpperCase().padStart(2, '0') +
-                                " = 0x" + $4.toString(16).toUpperCase().padStart(2, '0') +
-                                ", VF=" + $5.toString() + ")"); }, X, Y, oldVX, V[Y], V[X], V[0xF]);
-            PC += 2;
-            break;
+            op.kind = OP_00CN;
         }
-        case 0x0006: // store LSB in V[F] and shift V[X] right by one
-        {
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            uint8_t oldVX = V[X];
-            V[0xF] = (V[X] & 0x01); // store least significant bit in V[F]
-            V[X] = V[X] >> 1;       // shift V[X] right by 1
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] >> 1 (0x" +
-                                $1.toString(16).toUpperCase().padStart(2, '0') + " >> 1 = 0x" +
-                                $2.toString(16).toUpperCase().padStart(2, '0') +
-                                ", LSB = " + $3.toString() + ")"); }, X, oldVX, V[X], V[0xF]);
-            PC += 2;
-            break;
+        else if ((opcode & 0xFFF0) == 0x00D0)
+        {
+            op.kind = OP_00DN;
         }
-        case 0x0007: // perform V[X] = V[Y] - V[X], setting V[F] accordingly
+        else
         {
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            uint8_t Y = (opcode & 0x00F0) >> 4;
-            uint8_t oldVX = V[X]; // store old V[X] and V[Y] for logging
-            uint8_t oldVY = V[Y];
-            if (V[Y] >= V[X])
-            {
-                V[0xF] = 0x1; // no borrow occured, set V[F] to 1
-            }
-            else
+            switch (opcode)
             {
-                V[0xF] = 0x0; // borrow occured, set V[F] to 0
+            case 0x00FB: op.kind = OP_00FB; break;
+            case 0x00FC: op.kind = OP_00FC; break;
+            case 0x00FD: op.kind = OP_00FD; break;
+            case 0x00FE: op.kind = OP_00FE; break;
+            case 0x00FF: op.kind = OP_00FF; break;
+            default: op.kind = OP_0NNN; break; // machine code routine, ignored
             }
-            V[X] = V[Y] - V[X]; // perform the substraction
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] = V[" + $1.toString() +
-                                "] - V[" + $0.toString() + "] (0x" +
-                                $2.toString(16).toUpperCase().padStart(2, '0') +
-                                " - 0x" + $3.toString(16).toUpperCase().padStart(2, '0') +
-                                " = 0x" + $4.toString(16).toUpperCase().padStart(2, '0') +
-                                "), VF = " + $5.toString()); }, X, Y, oldVY, oldVX, V[X], V[0xF]);
-            PC += 2;
-            break;
-        }
-        case 0x000E: // store MSB in V[F] and left shift V[X]
-        {
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            uint8_t oldVX = V[X];
-            V[0xF] = (V[X] & 0x80) >> 7; // in a 8 bit (e.g. 10000000) value the MSB is in the 0x80 position (i.e. performing this results in 00000001 if V[X] was 10000000)
-            V[X] = V[X] << 1;            // left shift V[X] by 1
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] << 1 (0x" +
-                                $1.toString(16).toUpperCase().padStart(2, '0') +
-                                " << 1 = 0x" + $2.toString(16).toUpperCase().padStart(2, '0') +
-                                ", MSB = " + $3.toString() + ")"); }, X, oldVX, V[X], V[0xF]);
-            PC += 2;
-            break;
-        }
-        default:
-        {
-            PC += 2;
-        }
         }
         break;
-    }
-    case 0x9000: // skip next instruction if V[X] != V[Y]
-    {
-        uint8_t X = (opcode & 0x0F00) >> 8;
-        uint8_t Y = (opcode & 0x00F0) >> 4;
-        if (V[X] != V[Y])
+    case 0x1000:
+        op.kind = OP_1NNN;
+        break;
+    case 0x2000:
+        op.kind = OP_2NNN;
+        break;
+    case 0x3000:
+        op.kind = OP_3XNN;
+        break;
+    case 0x4000:
+        op.kind = OP_4XNN;
+        break;
+    case 0x5000:
+        switch (opcode & 0x000F)
         {
-            PC += 4;
-            EM_ASM_({ appendLog("Executed: Skip next instruction because V[" + $0.toString() + "] (0x" +
-                                $1.toString(16).toUpperCase().padStart(2, "0") + ") != V[" + $2.toString() +
-                                "] (0x" + $3.toString(16).toUpperCase().padStart(2, "0") + ")"); }, X, V[X], Y, V[Y]);
+        case 0x0002: op.kind = OP_5XY2; break;
+        case 0x0003: op.kind = OP_5XY3; break;
+        default: op.kind = OP_5XY0; break;
         }
-        else
+        break;
+    case 0x6000:
+        op.kind = OP_6XNN;
+        break;
+    case 0x7000:
+        op.kind = OP_7XNN;
+        break;
+    case 0x8000:
+        switch (opcode & 0x000F) // switching on the 0x8XY_ opcodes (distinguished by last nibble)
         {
-            EM_ASM_({ appendLog("Executed: No skip because V[" + $0.toString() + "] (0x" +
-                                $1.toString(16).toUpperCase().padStart(2, "0") + ") == V[" + $2.toString() +
-                                "] (0x" + $3.toString(16).toUpperCase().padStart(2, "0") + ")"); }, X, V[X], Y, V[Y]);
-            PC += 2;
+        case 0x0000: op.kind = OP_8XY0; break;
+        case 0x0001: op.kind = OP_8XY1; break;
+        case 0x0002: op.kind = OP_8XY2; break;
+        case 0x0003: op.kind = OP_8XY3; break;
+        case 0x0004: op.kind = OP_8XY4; break;
+        case 0x0005: op.kind = OP_8XY5; break;
+        case 0x0006: op.kind = OP_8XY6; break;
+        case 0x0007: op.kind = OP_8XY7; break;
+        case 0x000E: op.kind = OP_8XYE; break;
         }
         break;
-    }
+    case 0x9000:
+        op.kind = OP_9XY0;
+        break;
     case 0xA000:
-    {                                   // 0xANNN - Set index register I
-        uint16_t NNN = opcode & 0x0FFF; // Extract NNN (12-bit address)
-        I = NNN;
-        EM_ASM_({
-                var hexI = ("000" + $0.toString(16)).slice(-3);
-                appendLog("Executed: Set I = 0x" + hexI); }, NNN);
-        PC += 2;
+        op.kind = OP_ANNN;
         break;
-    }
     case 0xB000:
-    {                                      // 0xBNNN - set PC to NNN + V[0]
-        uint16_t NNN = opcode & 0x0FFF;    // extract NNN
-        uint16_t jumpAddress = NNN + V[0]; // Calculate jump address
-        EM_ASM_({
-        var hexAddr = ("000" + $0.toString(16)).slice(-3);
-        appendLog("Executed: Jump to address 0x" + hexAddr + " (NNN + V[0])"); }, jumpAddress);
-        PC = jumpAddress; // Set PC to NNN + V[0]
+        op.kind = OP_BNNN;
         break;
-    }
     case 0xC000:
-    { // 0xCXNN - Set V[X] = rand() & NN
-        uint8_t X = (opcode & 0x0F00) >> 8;
-        uint8_t NN = opcode & 0x00FF;
-        uint8_t rnd = rand() % 256; // generate random 8-bit value (0 to 255)
-        V[X] = rnd & NN;            // performn bitwise AND with NN and store in V[X]
-        EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] = Random(0x" +
-                            $1.toString(16).toUpperCase().padStart(2, '0') +
-                            ") & 0x" + $2.toString(16).toUpperCase().padStart(2, '0') +
-                            " = 0x" + $3.toString(16).toUpperCase().padStart(2, '0')); }, X, rnd, NN, V[X]);
-        PC += 2;
+        op.kind = OP_CXNN;
         break;
-    }
     case 0xD000:
-    {                                       // 0xDXYN - Draw sprite at (VX, VY) with height N
-        uint8_t X = (opcode & 0x0F00) >> 8; // Extract X
-        uint8_t Y = (opcode & 0x00F0) >> 4; // Extract Y
-        uint8_t N = opcode & 0x000F;
-        uint8_t xPos = V[X] % 64; // Ensure within 64x32 screen
-        uint8_t yPos = V[Y] % 32;
-        V[0xF] = 0; // Clear collision flag
-
-        for (int row = 0; row < N; row++)
-        {
-            uint8_t spriteByte = memory[I + row]; // Get sprite row from memory
-            for (int col = 0; col < 8; col++)
-            {
-                uint8_t pixel = (spriteByte >> (7 - col)) & 1; // Extract individual pixel
-                int drawX = (xPos + col) % 64;
-                int drawY = (yPos + row) % 32;
-                int screenIndex = drawY * 64 + drawX;
-                if (pixel == 1)
-                { // Only XOR if pixel is set
-                    if (display[screenIndex] == 1)
-                    {
-                        V[0xF] = 1; // Collision detected
-                    }
-                    display[screenIndex] ^= 1; // XOR pixel (toggle)
-                }
-            }
+        op.kind = OP_DXYN;
+        break;
+    case 0xE000:
+        switch (opcode & 0x00FF)
+        {
+        case 0x009E: op.kind = OP_EX9E; break;
+        case 0x00A1: op.kind = OP_EXA1; break;
+        }
+        break;
+    case 0xF000:
+        switch (opcode & 0x00FF)
+        {
+        case 0x0000: op.kind = opcode == 0xF000 ? OP_F000 : OP_UNKNOWN; break;
+        case 0x0001: op.kind = OP_FN01; break;
+        case 0x0002: op.kind = opcode == 0xF002 ? OP_F002 : OP_UNKNOWN; break;
+        case 0x0007: op.kind = OP_FX07; break;
+        case 0x000A: op.kind = OP_FX0A; break;
+        case 0x0015: op.kind = OP_FX15; break;
+        case 0x0018: op.kind = OP_FX18; break;
+        case 0x001E: op.kind = OP_FX1E; break;
+        case 0x0029: op.kind = OP_FX29; break;
+        case 0x0030: op.kind = OP_FX30; break;
+        case 0x0033: op.kind = OP_FX33; break;
+        case 0x003A: op.kind = OP_FX3A; break;
+        case 0x0055: op.kind = OP_FX55; break;
+        case 0x0065: op.kind = OP_FX65; break;
+        case 0x0075: op.kind = OP_FX75; break;
+        case 0x0085: op.kind = OP_FX85; break;
         }
-        EM_ASM_({ appendLog("Executed: Draw sprite at (V" + $0.toString() + ", V" + $1.toString() + ") with height " + $2.toString()); }, X, Y, N);
-        PC += 2;
         break;
     }
-    case 0xE000:
+    if (!extended && isExtendedOp(op.kind))
     {
-        uint8_t X = (opcode & 0x0F00) >> 8;
-        switch (opcode & 0x00FF)
+        // what these were before SUPER-CHIP: 00CN to 00FF machine code calls, the rest a plain 5XYN,
+        // which never skips, or invalid
+        op.kind = (opcode & 0xF000) == 0x0000 ? OP_0NNN : (opcode & 0xF000) == 0x5000 ? OP_5XY0 : OP_UNKNOWN;
+    }
+    return op;
+}
+
+template <QuirkProfile P>
+void Chip8::opDecode(const DecodedOp &)
+{
+    // first run of the instruction at PC: decode it into the cache, then execute it
+    uint16_t opcode = (memory[PC & 0x0FFF] << 8) | memory[(PC + 1) & 0x0FFF];
+    DecodedOp op = decode(opcode, Quirks<P>::extended);
+    decodeCache[PC & 0x0FFF] = op;
+    PROFILE_DECODED(op.kind);
+    executeWith<P>(op);
+}
+
+template <QuirkProfile P>
+void Chip8::op00E0(const DecodedOp &)
+{
+    clearDisplay(); // Set all pixels to 0 (off)
+    drawn = true;
+    TRACE_INSTR("Executed: Clear Screen (0x00E0)");
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op00EE(const DecodedOp &)
+{ // 0x00EE - return from subroutine
+    if (SP == 0)
+    {
+        //TRACE_INSTR("ERROR: Stack underflow on 0x00EE!!!");
+        return;
+    }
+    PC = stack[SP - 1]; // move the pointer
+    SP--;               // decrement stack pointer
+    PROFILE_CALLS();
+    TRACE_INSTR("Executed: Return from subroutine (0x00EE), jumping to 0x%03x", PC);
+    // PC explicity set, no increment
+}
+
+template <QuirkProfile P>
+void Chip8::op0NNN(const DecodedOp &)
+{ // 0x0NNN - call machine code routine, not supported so skipped
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::op00CN(const DecodedOp &op)
+{ // 0x00CN - scroll the display down by N pixels (SUPER-CHIP)
+    scrollDisplay(op.N, 0);
+    drawn = true;
+    TRACE_INSTR("Executed: Scroll down %d (0x00CN)", op.N);
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::op00DN(const DecodedOp &op)
+{ // 0x00DN - scroll the display up by N pixels (XO-CHIP)
+    scrollDisplay(-op.N, 0);
+    drawn = true;
+    TRACE_INSTR("Executed: Scroll up %d (0x00DN)", op.N);
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::op00FB(const DecodedOp &)
+{ // 0x00FB - scroll the display right by 4 pixels (SUPER-CHIP)
+    scrollDisplay(0, 4);
+    drawn = true;
+    TRACE_INSTR("Executed: Scroll right (0x00FB)");
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::op00FC(const DecodedOp &)
+{ // 0x00FC - scroll the display left by 4 pixels (SUPER-CHIP)
+    scrollDisplay(0, -4);
+    drawn = true;
+    TRACE_INSTR("Executed: Scroll left (0x00FC)");
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::op00FD(const DecodedOp &)
+{ // 0x00FD - exit the interpreter (SUPER-CHIP). There is nothing to exit to, so stay here for good
+    TRACE_INSTR("Executed: Exit (0x00FD)");
+    // PC not incremented
+}
+template <QuirkProfile P>
+void Chip8::op00FE(const DecodedOp &)
+{ // 0x00FE - switch to 64x32 low resolution (SUPER-CHIP)
+    setResolution(false);
+    drawn = true;
+    TRACE_INSTR("Executed: Low resolution (0x00FE)");
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::op00FF(const DecodedOp &)
+{ // 0x00FF - switch to 128x64 high resolution (SUPER-CHIP)
+    setResolution(true);
+    drawn = true;
+    TRACE_INSTR("Executed: High resolution (0x00FF)");
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op1NNN(const DecodedOp &op)
+{ // 0x1NNN - Set the program counter to NNN (Jump)
+    PC = op.NNN;
+    TRACE_INSTR("Executed: Jump to address 0x%03x", op.NNN);
+}
+
+template <QuirkProfile P>
+void Chip8::op2NNN(const DecodedOp &op)
+{ // 0x2NNN - Call subroutine at NNN
+    if (SP >= stack.size())
+    {
+        //TRACE_INSTR("ERROR: Stack overflow on 0x2NNN!!!");
+        return;
+    }
+    stack[SP] = PC + 2; // push return address to the stack
+    SP++;               // increment stack pointer
+    PC = op.NNN;        // set the PC to NNN to jump to the subroutine
+    PROFILE_CALLS();
+    TRACE_INSTR("Executed: Call subroutine at 0x%03x", op.NNN);
+}
+
+template <QuirkProfile P>
+void Chip8::op3XNN(const DecodedOp &op)
+{ // 0x3XNN - Skip next instruction if V[X] == NN
+    if (V[op.X] == op.NN)
+    {
+        PC += 2 + skippedLength<P>(); // skip the next instruction (2 bytes for current instruction + 2 for next)
+        TRACE_INSTR("Executed: Skip next instruction because V%d equals 0x%02X", op.X, op.NN);
+    }
+    else
+    {
+        PC += 2; // otherwise proceed as normal
+        TRACE_INSTR("Executed: No skip because V%d does not equal 0x%02X", op.X, op.NN);
+    }
+}
+
+template <QuirkProfile P>
+void Chip8::op4XNN(const DecodedOp &op)
+{ // 0x4XNN - Skip next instruction if V[X] != NN
+    if (V[op.X] != op.NN)
+    {
+        PC += 2 + skippedLength<P>(); // skip the next instruction (2 bytes for current and 2 bytes for next)
+        TRACE_INSTR("Executed: Skip next instruction because V%d not equals 0x%02X", op.X, op.NN);
+    }
+    else
+    {
+        PC += 2; // proceed as normal
+        TRACE_INSTR("Executed: No skip because V%d equals 0x%02X", op.X, op.NN);
+    }
+}
+
+template <QuirkProfile P>
+void Chip8::op5XY0(const DecodedOp &op)
+{ // 0x5XY0 - Skip next instruction if V[X] == V[Y] and opcode ends in 0
+    if ((V[op.X] == V[op.Y]) && op.N == 0)
+    {
+        PC += 2 + skippedLength<P>(); // skip next instruction (2 bytes for current + 2 for next)
+        TRACE_INSTR("Executed: Skip because V[%d] equals V[%d] and opcode ended in %d", op.X, op.Y, op.N);
+    }
+    else
+    {
+        PC += 2; // proceed as normal
+        TRACE_INSTR("Executed: No skip because V[%d] does not equal V[%d] or opcode did not end in %d", op.X, op.Y, op.N);
+    }
+}
+template <QuirkProfile P>
+void Chip8::op5XY2(const DecodedOp &op)
+{ // 0x5XY2 - store V[X] to V[Y] in memory from I, in that order even if X > Y, I unchanged (XO-CHIP)
+    int step = op.X <= op.Y ? 1 : -1;
+    int count = abs(op.X - op.Y) + 1;
+    for (int i = 0; i < count; i++)
+    {
+        writeMemory<P>(I + i, V[op.X + i * step]);
+    }
+    TRACE_INSTR("Executed: Stored V[%d] to V[%d] at I (0x%04X)", op.X, op.Y, I);
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::op5XY3(const DecodedOp &op)
+{ // 0x5XY3 - load V[X] to V[Y] from memory at I, the inverse of 5XY2 (XO-CHIP)
+    int step = op.X <= op.Y ? 1 : -1;
+    int count = abs(op.X - op.Y) + 1;
+    for (int i = 0; i < count; i++)
+    {
+        V[op.X + i * step] = memory[(I + i) & Quirks<P>::memoryMask];
+    }
+    TRACE_INSTR("Executed: Loaded V[%d] to V[%d] from I (0x%04X)", op.X, op.Y, I);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op6XNN(const DecodedOp &op)
+{ // 0x6XNN - Set VX to NN
+    V[op.X] = op.NN;
+    TRACE_INSTR("Executed: Set V%d = 0x%02X", op.X, op.NN);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op7XNN(const DecodedOp &op)
+{ // 0x7XNN - Add NN to VX
+    V[op.X] += op.NN; // Add NN to VX (no carry flag modification)
+    TRACE_INSTR("Executed: V%d += 0x%02X (New V%d = 0x%02X)", op.X, op.NN, op.X, V[op.X]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XY0(const DecodedOp &op)
+{ // 0x8XY0 - Set V[X] = V[Y]
+    V[op.X] = V[op.Y]; // setting the value in register Y to register X
+    TRACE_INSTR("Executed: V[%d] = V[%d] (0x%02X = 0x%02X)", op.X, op.Y, V[op.X], V[op.Y]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XY1(const DecodedOp &op)
+{ // 0x8XY1 - Set V[X] = V[X] | V[Y]
+    uint8_t oldVX = V[op.X];     // store original V[X] for logging
+    V[op.X] = V[op.X] | V[op.Y]; // perform bitwise OR (combine the bits)
+    TRACE_INSTR("Executed: V[%d] |= V[%d] (0x%02X |= 0x%02X => 0x%02X)", op.X, op.Y, oldVX, V[op.Y], V[op.X]);
+    if (Quirks<P>::resetVF)
+    {
+        V[0xF] = 0; // the VIP ran these through its ALU, which left the flag register cleared
+    }
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XY2(const DecodedOp &op)
+{ // 0x8XY2 - Set V[X] = V[X] & V[Y]
+    uint8_t oldVX = V[op.X];
+    V[op.X] = V[op.X] & V[op.Y];
+    TRACE_INSTR("Executed: V[%d] &= V[%d] (0x%02X &= 0x%02X => 0x%02X)", op.X, op.Y, oldVX, V[op.Y], V[op.X]);
+    if (Quirks<P>::resetVF)
+    {
+        V[0xF] = 0; // the VIP ran these through its ALU, which left the flag register cleared
+    }
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XY3(const DecodedOp &op)
+{ // 0x8XY3 - Set V[X] = V[X] ^ V[Y]
+    uint8_t oldVX = V[op.X];
+    V[op.X] = V[op.X] ^ V[op.Y];
+    TRACE_INSTR("Executed: V[%d] ^= V[%d] (0x%02X ^= 0x%02X => 0x%02X)", op.X, op.Y, oldVX, V[op.Y], V[op.X]);
+    if (Quirks<P>::resetVF)
+    {
+        V[0xF] = 0; // the VIP ran these through its ALU, which left the flag register cleared
+    }
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XY4(const DecodedOp &op)
+{ // 0x8XY4 - Perform V[X] = V[X] + V[Y]
+    uint8_t oldVX = V[op.X]; // store old V[X] for logging
+    uint16_t sum = V[op.X] + V[op.Y];
+    // if sum is over 0xFF (255) we store 1 in the carry flag V[0xF], else 0
+    V[0xF] = sum > 0xFF ? 0x1 : 0x0;
+    V[op.X] = (sum & 0xFF); // store the lower 8 bits in V[X]
+    TRACE_INSTR("Executed: V[%d] = V[%d] + V[%d] (0x%02X + 0x%02X = 0x%03X, carry=%d) => new V[%d] = 0x%02X",
+                op.X, op.X, op.Y, oldVX, V[op.Y], sum, V[0xF], op.X, V[op.X]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XY5(const DecodedOp &op)
+{ // 0x8XY5 - Perform V[X] = V[X] - V[Y]
+    uint8_t oldVX = V[op.X]; // store old V[X] for logging
+    // if V[X] is >= V[Y] set carry flag (V[F]) to 1 else 0
+    V[0xF] = V[op.X] >= V[op.Y] ? 0x1 : 0x0;
+    V[op.X] = V[op.X] - V[op.Y]; // perform the subtraction
+    TRACE_INSTR("Executed: V[%d] -= V[%d] (0x%02X - 0x%02X = 0x%02X, VF=%d)", op.X, op.Y, oldVX, V[op.Y], V[op.X], V[0xF]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XY6(const DecodedOp &op)
+{ // 0x8XY6 - store LSB in V[F] and shift V[X] right by one
+    uint8_t oldVX = V[op.X];
+    uint8_t source = Quirks<P>::shiftVX ? V[op.X] : V[op.Y]; // the VIP shifted V[Y] into V[X]
+    V[0xF] = (source & 0x01); // store least significant bit in V[F]
+    V[op.X] = (Quirks<P>::shiftVX ? V[op.X] : source) >> 1; // V[X] re-read, for 8FY6 that is the flag
+    TRACE_INSTR("Executed: V[%d] >> 1 (0x%02X >> 1 = 0x%02X, LSB = %d)", op.X, oldVX, V[op.X], V[0xF]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XY7(const DecodedOp &op)
+{ // 0x8XY7 - perform V[X] = V[Y] - V[X], setting V[F] accordingly
+    uint8_t oldVX = V[op.X]; // store old V[X] and V[Y] for logging
+    uint8_t oldVY = V[op.Y];
+    // no borrow occured: V[F] = 1, borrow occured: V[F] = 0
+    V[0xF] = V[op.Y] >= V[op.X] ? 0x1 : 0x0;
+    V[op.X] = V[op.Y] - V[op.X]; // perform the substraction
+    TRACE_INSTR("Executed: V[%d] = V[%d] - V[%d] (0x%02X - 0x%02X = 0x%02X), VF = %d", op.X, op.Y, op.X, oldVY, oldVX, V[op.X], V[0xF]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op8XYE(const DecodedOp &op)
+{ // 0x8XYE - store MSB in V[F] and left shift V[X]
+    uint8_t oldVX = V[op.X];
+    uint8_t source = Quirks<P>::shiftVX ? V[op.X] : V[op.Y];
+    V[0xF] = (source & 0x80) >> 7; // in a 8 bit (e.g. 10000000) value the MSB is in the 0x80 position (i.e. performing this results in 00000001 if V[X] was 10000000)
+    V[op.X] = (Quirks<P>::shiftVX ? V[op.X] : source) << 1; // left shift by 1, V[X] re-read as above
+    TRACE_INSTR("Executed: V[%d] << 1 (0x%02X << 1 = 0x%02X, MSB = %d)", op.X, oldVX, V[op.X], V[0xF]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::op9XY0(const DecodedOp &op)
+{ // 0x9XY0 - skip next instruction if V[X] != V[Y]
+    if (V[op.X] != V[op.Y])
+    {
+        PC += 2 + skippedLength<P>();
+        TRACE_INSTR("Executed: Skip next instruction because V[%d] (0x%02X) != V[%d] (0x%02X)", op.X, V[op.X], op.Y, V[op.Y]);
+    }
+    else
+    {
+        TRACE_INSTR("Executed: No skip because V[%d] (0x%02X) == V[%d] (0x%02X)", op.X, V[op.X], op.Y, V[op.Y]);
+        PC += 2;
+    }
+}
+
+template <QuirkProfile P>
+void Chip8::opANNN(const DecodedOp &op)
+{ // 0xANNN - Set index register I
+    I = op.NNN;
+    TRACE_INSTR("Executed: Set I = 0x%03x", op.NNN);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opBNNN(const DecodedOp &op)
+{ // 0xBNNN - set PC to NNN + V[0], or on CHIP-48 and SUPER-CHIP to XNN + V[X]
+    uint16_t jumpAddress = op.NNN + V[Quirks<P>::jumpVX ? op.X : 0]; // Calculate jump address
+    TRACE_INSTR("Executed: Jump to address 0x%03x (NNN + V[0])", jumpAddress);
+    PC = jumpAddress; // Set PC to NNN + V[0]
+}
+
+template <QuirkProfile P>
+void Chip8::opCXNN(const DecodedOp &op)
+{                               // 0xCXNN - Set V[X] = random & NN
+    uint8_t rnd = nextRandom(); // generate random 8-bit value (0 to 255)
+    V[op.X] = rnd & op.NN;      // performn bitwise AND with NN and store in V[X]
+    TRACE_INSTR("Executed: V[%d] = Random(0x%02X) & 0x%02X = 0x%02X", op.X, rnd, op.NN, V[op.X]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opDXYN(const DecodedOp &op)
+{ // 0xDXYN - Draw sprite at (VX, VY) with height N, DXY0 draws a 16x16 sprite (SUPER-CHIP, XO-CHIP)
+    PROFILE_DRAW();
+    uint64_t changed = 0;
+    uint64_t collision = hires ? drawSprite<P, true>(op, changed) : drawSprite<P, false>(op, changed);
+    V[0xF] = collision != 0;
+    dirtyRows |= changed;
+    drawn = true;
+    TRACE_INSTR("Executed: Draw sprite at (V%d, V%d) with height %d", op.X, op.Y, op.N);
+    PC += 2;
+}
+
+template <QuirkProfile P, bool High>
+uint64_t Chip8::drawSprite(const DecodedOp &op, uint64_t &changed)
+{
+    const int height = High ? 64 : 32;
+    unsigned xPos = V[op.X] % (High ? 128 : 64); // the start always wraps, only the sprite is clipped
+    int yPos = V[op.Y] % height;
+    bool wide = Quirks<P>::extended && op.N == 0; // otherwise DXY0 draws no rows, as CHIP-8 always did
+    int rows = wide ? 16 : op.N;
+    uint16_t address = I;
+    uint64_t collision = 0;
+
+    for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+    {
+        if (!((planes >> plane) & 1))
+        {
+            continue;
+        }
+        uint64_t *planeWords = planeRows(plane);
+        for (int row = 0; row < rows; row++)
         {
-        case 0x009E:
-        { // 0xEX9E - Skip next instruction if V[X] is pressed
-            if (keys[V[X]] != 0)
+            if (Quirks<P>::clipSprites && yPos + row >= height)
             {
-                EM_ASM_({ appendLog("Executed: Skip next instruction because key for V[" + $0.toString() +
-                                    "] (key value: 0x" + $1.toString(16).toUpperCase().padStart(1, '0') + ") is pressed."); }, X, V[X]);
-                PC += 4;
+                break; // cut off at the bottom edge
             }
-            else
+            // line the sprite row up at x = 0 as the top bits of a word, then move it into place:
+            // either rotated so it wraps around the right edge, or shifted so whatever passes the
+            // edge is cut off. A high resolution row is two words, the sprite may straddle them.
+            uint16_t at = address + (wide ? row * 2 : row);
+            uint64_t line = wide ? uint64_t((memory[at & Quirks<P>::memoryMask] << 8) |
+                                            memory[(at + 1) & Quirks<P>::memoryMask]) << 48
+                                 : uint64_t(memory[at & Quirks<P>::memoryMask]) << 56;
+            int y = (yPos + row) % height;
+            uint64_t *words = planeWords + y * DISPLAY_ROW_WORDS;
+            if (!High)
             {
-                EM_ASM_({ appendLog("Executed: No skip because key for V[" + $0.toString() +
-                                    "] (key value: 0x" + $1.toString(16).toUpperCase().padStart(1, '0') + ") is not pressed."); }, X, V[X]);
-                PC += 2;
+                uint64_t bits = Quirks<P>::clipSprites ? line >> xPos : rotateRight(line, xPos);
+                collision |= words[0] & bits; // any pixel turned off
+                words[0] ^= bits;
+                changed |= uint64_t(bits != 0) << y;
+                continue;
             }
-            break;
-        }
-        case 0x00A1:
-        { // 0x8XA1 - Skip next instruction if V[X] is not pressed
-            if (keys[V[X]] == 0)
+            uint64_t left;
+            uint64_t right;
+            if (xPos < 64)
             {
-                EM_ASM_({ appendLog("Executed: Skip next instruction because key for V[" + $0.toString() +
-                                    "] (key value: 0x" + $1.toString(16).toUpperCase().padStart(1, '0') +
-                                    ") is not pressed."); }, X, V[X]);
-
-                PC += 4;
+                left = line >> xPos;
+                right = xPos == 0 ? 0 : line << (64 - xPos); // at most 16 wide, never past the right edge
             }
             else
             {
-                EM_ASM_({ appendLog("Executed: No skip because key for V[" + $0.toString() +
-                                    "] (key value: 0x" + $1.toString(16).toUpperCase().padStart(1, '0') +
-                                    ") is pressed."); }, X, V[X]);
-                PC += 2;
+                unsigned shift = xPos - 64;
+                right = line >> shift;
+                left = Quirks<P>::clipSprites || shift == 0 ? 0 : line << (64 - shift);
             }
-            break;
+            collision |= (words[0] & left) | (words[1] & right);
+            words[0] ^= left;
+            words[1] ^= right;
+            changed |= uint64_t((left | right) != 0) << y;
         }
-        default:
+        address += wide ? rows * 2 : rows; // with both planes selected, the second plane's sprite follows the first's
+    }
+    return collision;
+}
+
+template <QuirkProfile P>
+void Chip8::opEX9E(const DecodedOp &op)
+{ // 0xEX9E - Skip next instruction if V[X] is pressed
+    if (keys[V[op.X]] != 0)
+    {
+        TRACE_INSTR("Executed: Skip next instruction because key for V[%d] (key value: 0x%X) is pressed.", op.X, V[op.X]);
+        PC += 2 + skippedLength<P>();
+    }
+    else
+    {
+        TRACE_INSTR("Executed: No skip because key for V[%d] (key value: 0x%X) is not pressed.", op.X, V[op.X]);
+        PC += 2;
+    }
+}
+
+template <QuirkProfile P>
+void Chip8::opEXA1(const DecodedOp &op)
+{ // 0xEXA1 - Skip next instruction if V[X] is not pressed
+    if (keys[V[op.X]] == 0)
+    {
+        TRACE_INSTR("Executed: Skip next instruction because key for V[%d] (key value: 0x%X) is not pressed.", op.X, V[op.X]);
+        PC += 2 + skippedLength<P>();
+    }
+    else
+    {
+        TRACE_INSTR("Executed: No skip because key for V[%d] (key value: 0x%X) is pressed.", op.X, V[op.X]);
+        PC += 2;
+    }
+}
+
+template <QuirkProfile P>
+void Chip8::opF000(const DecodedOp &)
+{ // 0xF000 NNNN - load I with the 16-bit address in the next two bytes (XO-CHIP)
+    I = (memory[(PC + 2) & 0x0FFF] << 8) | memory[(PC + 3) & 0x0FFF];
+    TRACE_INSTR("Executed: I = 0x%04X (0xF000)", I);
+    PC += 4;
+}
+template <QuirkProfile P>
+void Chip8::opFN01(const DecodedOp &op)
+{ // 0xFN01 - select the bit-planes that draws, clears and scrolls apply to, bit n for plane n (XO-CHIP)
+    planes = op.X & ((1 << DISPLAY_PLANES) - 1);
+    TRACE_INSTR("Executed: Planes = %d (0xFN01)", planes);
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::opF002(const DecodedOp &)
+{ // 0xF002 - load the 16-byte audio pattern from memory at I (XO-CHIP)
+    for (size_t i = 0; i < audioPattern.size(); i++)
+    {
+        audioPattern[i] = memory[(I + i) & Quirks<P>::memoryMask];
+    }
+    TRACE_INSTR("Executed: Audio pattern loaded from I (0x%04X)", I);
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::opFX07(const DecodedOp &op)
+{ // 0xFX07 - Set V[X] to current value of delay timer
+    V[op.X] = delayTimer;
+    TRACE_INSTR("Executed: V[%d] = delayTimer (0x%02X)", op.X, delayTimer);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opFX0A(const DecodedOp &op)
+{ // 0xFX0A - Wait for key press, store the key in V[X]
+    bool keyPressed = false;
+    for (uint8_t i = 0; i < keys.size(); i++)
+    {
+        if (keys[i] != 0)
         {
-            PC += 2;
+            V[op.X] = i; // key press detected, storing key index in V[X]
+            keyPressed = true;
+            TRACE_INSTR("Executed: Key press detected - key 0x%X stored in V[%d]", i, op.X);
             break;
         }
-        }
-        break;
     }
-    case 0xF000:
+    waitingForKey = !keyPressed;
+    if (!keyPressed)
     {
-        switch (opcode & 0x00FF)
+        PROFILE_KEY_WAIT(1);
+        return; // don't increment PC, causing a retry of this opcode
+    }
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opFX15(const DecodedOp &op)
+{ // 0xFX15 - Set delay timer to V[X]
+    delayTimer = V[op.X];
+    TRACE_INSTR("Executed: delayTimer = V[%d] (0x%02X)", op.X, V[op.X]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opFX18(const DecodedOp &op)
+{ // 0xFX18 - Set sound timer to V[X]
+    soundTimer = V[op.X];
+    TRACE_INSTR("Executed: soundTimer = V[%d] (0x%02X)", op.X, V[op.X]);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opFX1E(const DecodedOp &op)
+{ // 0xFX1E - Add V[X] to I
+    uint16_t oldI = I;
+    I += V[op.X]; // perform addition
+    TRACE_INSTR("Executed: I = I + V[%d] (0x%03X + 0x%02X = 0x%03X)", op.X, oldI, V[op.X], I);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opFX29(const DecodedOp &op)
+{ // 0xFX29 - Set I to the location of the sprite for the digit in V[X]
+    uint8_t digit = V[op.X];
+    I = FONT_START_ADDRESS + (digit * 5); // each sprite is 5 bytes
+    TRACE_INSTR("Executed: I = FONT_START_ADDRESS + (V[%d] * 5) (0x%03X + (0x%02X * 5) = 0x%03X)", op.X, FONT_START_ADDRESS, digit, I);
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::opFX30(const DecodedOp &op)
+{ // 0xFX30 - Set I to the 8x10 sprite for the digit in V[X] (SUPER-CHIP)
+    I = BIG_FONT_START_ADDRESS + (V[op.X] & 0x0F) * 10; // each sprite is 10 bytes
+    TRACE_INSTR("Executed: I = big digit V[%d] (0x%03X)", op.X, I);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opFX33(const DecodedOp &op)
+{ // 0xFX33 - Store BCD of V[X] in memory at I, I + 1, I + 2
+    uint8_t value = V[op.X];
+    writeMemory<P>(I, value / 100);           // hundred digit
+    writeMemory<P>(I + 1, (value / 10) % 10); // tens digit
+    writeMemory<P>(I + 2, value % 10);        // ones digit
+    TRACE_INSTR("Executed: BCD of V[%d] (0x%02X) stored at memory[I..I+2] as: hundreds=0x%02X, tens=0x%02X, ones=0x%02X",
+                op.X, value, value / 100, (value / 10) % 10, value % 10);
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::opFX3A(const DecodedOp &op)
+{ // 0xFX3A - set the audio pattern's pitch to V[X] (XO-CHIP)
+    pitch = V[op.X];
+    TRACE_INSTR("Executed: Pitch = V[%d] (%d)", op.X, pitch);
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opFX55(const DecodedOp &op)
+{ // 0xFX55 - Store registers V0 to VX in memory
+    for (uint8_t i = 0; i <= op.X; i++)
+    {
+        writeMemory<P>(I + i, V[i]);
+    }
+    TRACE_INSTR("Executed: Loaded registers V0 to V[%d] from memory starting at I (0x%03X)", op.X, I);
+    if (Quirks<P>::memoryIndex != INDEX_UNCHANGED)
+    {
+        I += Quirks<P>::memoryIndex == INDEX_PLUS_X ? op.X : op.X + 1;
+    }
+    PC += 2;
+}
+
+template <QuirkProfile P>
+void Chip8::opFX65(const DecodedOp &op)
+{ // 0xFX65 - Load registers V0 to VX from memory
+    for (uint8_t i = 0; i <= op.X; i++)
+    {
+        V[i] = memory[(I + i) & Quirks<P>::memoryMask];
+    }
+    TRACE_INSTR("Executed: Loaded registers V0 to V[%d] from memory starting at I (0x%03X)", op.X, I);
+    if (Quirks<P>::memoryIndex != INDEX_UNCHANGED)
+    {
+        I += Quirks<P>::memoryIndex == INDEX_PLUS_X ? op.X : op.X + 1;
+    }
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::opFX75(const DecodedOp &op)
+{ // 0xFX75 - save V0 to V[X] in the RPL user flags (SUPER-CHIP)
+    for (uint8_t i = 0; i <= op.X; i++)
+    {
+        flags[i] = V[i];
+    }
+    TRACE_INSTR("Executed: Saved V0 to V[%d] to the RPL flags", op.X);
+    PC += 2;
+}
+template <QuirkProfile P>
+void Chip8::opFX85(const DecodedOp &op)
+{ // 0xFX85 - load V0 to V[X] from the RPL user flags (SUPER-CHIP)
+    for (uint8_t i = 0; i <= op.X; i++)
+    {
+        V[i] = flags[i];
+    }
+    TRACE_INSTR("Executed: Loaded V0 to V[%d] from the RPL flags", op.X);
+    PC += 2;
+}
+
+void Chip8::opUnknown(const DecodedOp &)
+{
+    TRACE_INSTR("Executed: Unknown opcode encountered.");
+    PC += 2;
+}
+
+const char *Chip8::drainTrace()
+{
+#if CHIP8_TRACE_LEVEL >= CHIP8_TRACE_INSTR
+    return trace.drain();
+#else
+    return "";
+#endif
+}
+
+std::string Chip8::getProfileReport() const
+{
+#if CHIP8_PROFILE
+    return profile.report(memory.data(), quirkExtended(quirks));
+#else
+    return "";
+#endif
+}
+
+std::string Chip8::getProfileStacks() const
+{
+#if CHIP8_PROFILE
+    return profile.collapsed();
+#else
+    return "";
+#endif
+}
+
+void Chip8::clearProfile()
+{
+#if CHIP8_PROFILE
+    profile.clear();
+    PROFILE_CALLS(); // count from the current stack on
+#endif
+}
+
+void Chip8::clearDisplay()
+{
+    uint64_t changed = 0;
+    for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+    {
+        if (!((planes >> plane) & 1))
         {
-        case 0x0007:
-        { // 0xFX07 - Set V[X] to current value of delay timer
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            V[X] = delayTimer;
-            EM_ASM_({ appendLog("Executed: V[" + $0.toString() + "] = delayTimer (0x" +
-                                $1.toString(16).toUpperCase().padStart(2, '0') + ")"); }, X, delayTimer);
-            PC += 2;
-            break;
+            continue;
         }
-        case 0x000A:
-        { // 0xFX0A - Wait for key press, store the key in V[X]
-            bool keyPressed = false;
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            for (uint8_t i = 0; i < keys.size(); i++)
-            {
-                if (keys[i] != 0)
-                {
-                    V[X] = i; // key press detected, storing key index in V[X]
-                    keyPressed = true;
-                    EM_ASM_({ appendLog("Executed: Key press detected - key 0x" +
-                                        $0.toString(16).toUpperCase() +
-                                        " stored in V[" + $1.toString() + "]"); }, i, X);
-                    break;
-                }
-            }
-            if (!keyPressed)
-            {
-                return; // don't increment PC, causing a retry of this opcode
-            }
-            PC += 2;
-            break;
-        }
-        case 0x0015:
-        { // 0xFX15 - Set delay timer to V[X]
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            delayTimer = V[X];
-            EM_ASM_({ appendLog("Executed: delayTimer = V[" + $0.toString() + "] (0x" +
-                                $1.toString(16).toUpperCase().padStart(2, '0') + ")"); }, X, V[X]);
-            PC += 2;
-            break;
+        uint64_t *rows = planeRows(plane);
+        for (int y = 0; y < getDisplayHeight(); y++) // rows below are blank in low resolution
+        {
+            uint64_t *words = rows + y * DISPLAY_ROW_WORDS;
+            changed |= uint64_t((words[0] | words[1]) != 0) << y;
+            words[0] = 0;
+            words[1] = 0;
         }
-        case 0x0018:
-        { // 0xFX18 - Set sound timer to V[X]
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            soundTimer = V[X];
-            EM_ASM_({ appendLog("Executed: soundTimer = V[" + $0.toString() + "] (0x" +
-                                $1.toString(16).toUpperCase().padStart(2, '0') + ")"); }, X, V[X]);
-            PC += 2;
-            break;
+    }
+    dirtyRows |= changed;
+}
+
+void Chip8::scrollDisplay(int down, int right)
+{
+    int height = getDisplayHeight();
+    size_t rowBytes = DISPLAY_ROW_WORDS * sizeof(uint64_t);
+    int distance = std::min(abs(down), height);
+    bool changed = false;
+    for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+    {
+        if (!((planes >> plane) & 1))
+        {
+            continue;
         }
-        case 0x001E:
-        { // 0xFX1E - Add V[X] to I
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            uint16_t oldI = I;
-            I += V[X]; // perform addition
-            EM_ASM_({ appendLog("Executed: I = I + V[" + $0.toString() +
-                                "] (0x" + $1.toString(16).toUpperCase().padStart(3, '0') +
-                                " + 0x" + $2.toString(16).toUpperCase().padStart(2, '0') +
-                                " = 0x" + $3.toString(16).toUpperCase().padStart(3, '0') + ")"); }, X, oldI, V[X], I);
-            PC += 2;
-            break;
+        uint64_t *rows = planeRows(plane);
+        for (int i = 0; i < height * DISPLAY_ROW_WORDS; i++)
+        {
+            changed |= rows[i] != 0;
         }
-        case 0x0029:
-        { // 0xFX29 - Set I to the location of the sprite for the digit in V[X]
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            uint8_t digit = V[X];
-            I = FONT_START_ADDRESS + (digit * 5); // each sprite is 5 bytes
-            EM_ASM_({ appendLog("Executed: I = FONT_START_ADDRESS + (V[" + $0.toString() +
-                                "] * 5) (0x" + $1.toString(16).toUpperCase().padStart(3, '0') +
-                                " + (0x" + $2.toString(16).toUpperCase().padStart(2, '0') +
-                                " * 5) = 0x" + $3.toString(16).toUpperCase().padStart(3, '0') + ")"); }, X, FONT_START_ADDRESS, digit, I);
-            PC += 2;
-            break;
+        // vertically whole rows move, horizontally each row shifts a word at a time, carrying
+        // across the word boundary in high resolution. Whatever is scrolled in is blank.
+        if (down > 0)
+        {
+            memmove(rows + distance * DISPLAY_ROW_WORDS, rows, (height - distance) * rowBytes);
+            memset(rows, 0, distance * rowBytes);
         }
-        case 0x0033:
-        { // 0xFX33 - Store BCD of V[X] in memory at I, I + 1, I + 2
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            uint8_t value = V[X];
-            memory[I] = value / 100;           // hundred digit
-            memory[I + 1] = (value / 10) % 10; // tens digit
-            memory[I + 2] = value % 10;        // ones digit
-            EM_ASM_({ appendLog("Executed: BCD of V[" + $0.toString() +
-                                "] (0x" + $1.toString(16).toUpperCase().padStart(2, '0') +
-                                ") stored at memory[I..I+2] as: hundreds=0x" +
-                                $2.toString(16).toUpperCase().padStart(2, '0') +
-                                ", tens=0x" + $3.toString(16).toUpperCase().padStart(2, '0') +
-                                ", ones=0x" + $4.toString(16).toUpperCase().padStart(2, '0')); }, X, value, memory[I], memory[I + 1], memory[I + 2]);
-            PC += 2;
-            break;
+        else if (down < 0)
+        {
+            memmove(rows, rows + distance * DISPLAY_ROW_WORDS, (height - distance) * rowBytes);
+            memset(rows + (height - distance) * DISPLAY_ROW_WORDS, 0, distance * rowBytes);
         }
-        case 0x0055:
-        { // 0xFX55 - Store registers V0 to VX in memory
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            for (uint8_t i = 0; i <= X; i++)
+        for (int y = 0; right != 0 && y < height; y++)
+        {
+            uint64_t *words = rows + y * DISPLAY_ROW_WORDS;
+            if (!hires)
             {
-                memory[I + i] = V[i];
+                words[0] = right > 0 ? words[0] >> right : words[0] << -right;
+            }
+            else if (right > 0)
+            {
+                words[1] = (words[1] >> right) | (words[0] << (64 - right));
+                words[0] >>= right;
+            }
+            else
+            {
+                words[0] = (words[0] << -right) | (words[1] >> (64 + right));
+                words[1] <<= -right;
             }
-            EM_ASM_({ appendLog("Executed: Loaded registers V0 to V[" + $0.toString() + "] from memory starting at I (0x" +
-                                $1.toString(16).toUpperCase().padStart(3, '0') + ")"); }, X, I);
-            PC += 2;
-            break;
         }
-        case 0x0065:
-        { // 0xFX65 - Load registers V0 to VX from memory
-            uint8_t X = (opcode & 0x0F00) >> 8;
-            for (uint8_t i = 0; i <= X; i++)
+    }
+    if (changed)
+    {
+        dirtyRows |= height == 64 ? ~0ULL : (1ULL << height) - 1;
+    }
+}
+
+void Chip8::setResolution(bool high)
+{
+    hires = high;
+    display.fill(0); // every plane, whatever is selected
+    dirtyRows = ~0ULL;
+}
+
+uint8_t Chip8::storedPlanes() const
+{
+    uint8_t stored = 1;
+    for (int plane = 1; plane < DISPLAY_PLANES; plane++)
+    {
+        const uint64_t *rows = getDisplayPlane(plane);
+        if (std::any_of(rows, rows + DISPLAY_PLANE_WORDS, [](uint64_t word) { return word != 0; }))
+        {
+            stored |= 1 << plane;
+        }
+    }
+    return stored;
+}
+
+uint64_t Chip8::getDisplayHash() const
+{
+    uint64_t hash = 14695981039346656037ULL; // each row's bytes from the leftmost pixel on
+    int words = hires ? DISPLAY_ROW_WORDS : 1;
+    uint8_t stored = storedPlanes(); // a blank second plane is left out, so plain CHIP-8 hashes are what they always were
+    for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+    {
+        if (!((stored >> plane) & 1))
+        {
+            continue;
+        }
+        const uint64_t *rows = getDisplayPlane(plane);
+        for (int y = 0; y < getDisplayHeight(); y++)
+        {
+            for (int w = 0; w < words; w++)
             {
-                V[i] = memory[I + i];
+                uint64_t row = rows[y * DISPLAY_ROW_WORDS + w];
+                for (int shift = 56; shift >= 0; shift -= 8)
+                {
+                    hash ^= (row >> shift) & 0xFF;
+                    hash *= 1099511628211ULL;
+                }
             }
-            EM_ASM_({ appendLog("Executed: Loaded registers V0 to V[" + $0.toString() + "] from memory starting at I (0x" +
-                                $1.toString(16).toUpperCase().padStart(3, '0') + ")"); }, X, I);
-            PC += 2;
-            break;
         }
-        default:
+    }
+    return hash;
+}
+
+void Chip8::present()
+{
+    if (dirtyRows == 0)
+    {
+        return;
+    }
+    // the back buffer was the front before the last publish, so it lacks that publish's rows too
+    uint8_t back = frontFrame ^ 1;
+    Frame &frame = frames[back];
+    uint64_t stale = dirtyRows | publishedRows;
+    for (int y = 0; y < DISPLAY_MAX_HEIGHT; y++)
+    {
+        if (!((stale >> y) & 1))
         {
-            PC += 2;
-            break;
+            continue;
         }
+        for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+        {
+            size_t row = plane * DISPLAY_PLANE_WORDS + y * DISPLAY_ROW_WORDS;
+            std::copy_n(display.begin() + row, DISPLAY_ROW_WORDS, frame.planes.begin() + row);
         }
-        break;
     }
-    default:
-        EM_ASM({
-            appendLog("Executed: Unknown opcode encountered.");
-        });
-        PC += 2;
-        break;
+    frame.hires = hires;
+    frontFrame = back;
+    frameSequence++;
+    presentedRows |= dirtyRows;
+    publishedRows = dirtyRows;
+    dirtyRows = 0;
+    if (frameListener)
+    {
+        frameListener(*this);
     }
 }
 
+uint64_t Chip8::takeDirtyRows()
+{
+    uint64_t rows = presentedRows;
+    presentedRows = 0;
+    return rows;
+}
+
 uint8_t *Chip8::getDisplayBuffer()
 {
-    return display.data(); // Return pointer to display array
+    int width = getDisplayWidth();
+    int height = getDisplayHeight();
+    unpackedDisplay.assign(width * height, 0);
+    for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+    {
+        const uint64_t *rows = getDisplayPlane(plane);
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                uint64_t word = rows[y * DISPLAY_ROW_WORDS + x / 64];
+                unpackedDisplay[y * width + x] |= ((word >> (63 - x % 64)) & 1) << plane;
+            }
+        }
+    }
+    return unpackedDisplay.data();
 }
@@ -0,0 +1,147 @@
+#include "../includes/corethread.h"
+#include <algorithm>
+#include <chrono>
+
+CoreThread::CoreThread(Chip8 &chip8) : chip8(chip8)
+{
+    keyHandler = [](Chip8 &chip, uint8_t key, uint8_t state) { chip.setKeyState(key, state); };
+    chip8.setFrameListener([this](const Chip8 &published) { publish(published); });
+    publish(chip8); // the frame already up, published before anyone listened
+}
+
+CoreThread::~CoreThread()
+{
+    {
+        std::lock_guard<std::mutex> guard(control);
+        quitting = true;
+    }
+    wake.notify_all();
+    if (worker.joinable())
+    {
+        worker.join();
+    }
+}
+
+bool CoreThread::start()
+{
+#if CHIP8_THREADS
+    if (!worker.joinable())
+    {
+        worker = std::thread(&CoreThread::loop, this);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+void CoreThread::setPaused(bool paused)
+{
+    {
+        std::lock_guard<std::mutex> guard(control);
+        this->paused = paused;
+    }
+    wake.notify_all();
+}
+
+std::unique_lock<std::mutex> CoreThread::hold()
+{
+    return std::unique_lock<std::mutex>(lock);
+}
+
+void CoreThread::setKeyState(uint8_t key, uint8_t state)
+{
+    if (key > 0xF)
+    {
+        return;
+    }
+    uint32_t bit = 1u << key;
+    if (state)
+    {
+        heldKeys.fetch_or(bit, std::memory_order_release);
+        tappedKeys.fetch_or(bit, std::memory_order_release);
+    }
+    else
+    {
+        heldKeys.fetch_and(~bit, std::memory_order_release);
+    }
+}
+
+void CoreThread::applyKeys()
+{
+    uint32_t wanted = heldKeys.load(std::memory_order_acquire) | tappedKeys.exchange(0, std::memory_order_acq_rel);
+    uint32_t changed = wanted ^ appliedKeys;
+    appliedKeys = wanted;
+    for (uint8_t key = 0; changed != 0; key++, changed >>= 1)
+    {
+        if (changed & 1)
+        {
+            keyHandler(chip8, key, (wanted >> key) & 1);
+        }
+    }
+}
+
+void CoreThread::publish(const Chip8 &published)
+{
+    Frame &frame = frames[back];
+    std::copy_n(published.getFramePlane(0), frame.planes.size(), frame.planes.begin()); // both planes, they're contiguous
+    frame.hires = published.getFrameWidth() == 128;
+    frame.sequence = published.getFrameSequence();
+    uint64_t rows = published.getPublishedRows();
+    untakenRows |= rows;
+    frame.rows = untakenRows;
+    uint8_t previous = middle.exchange(back | FRESH, std::memory_order_acq_rel);
+    back = previous & 3;
+    if (!(previous & FRESH))
+    {
+        untakenRows = rows; // the host took the frame before this one, which is all later frames need to cover
+    }
+}
+
+bool CoreThread::takeFrame()
+{
+    if (!(middle.load(std::memory_order_acquire) & FRESH))
+    {
+        return false;
+    }
+    front = middle.exchange(front, std::memory_order_acq_rel) & 3;
+    shownRows |= frames[front].rows;
+    return true;
+}
+
+uint64_t CoreThread::takeDirtyRows()
+{
+    uint64_t rows = shownRows;
+    shownRows = 0;
+    return rows;
+}
+
+void CoreThread::loop()
+{
+    using Clock = std::chrono::steady_clock;
+    const auto period = std::chrono::microseconds(1000000 / SLICE_HZ);
+    Clock::time_point last = Clock::now();
+    Clock::time_point next = last + period;
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> guard(control);
+            wake.wait_until(guard, next, [this] { return quitting; });
+            if (paused)
+            {
+                wake.wait(guard, [this] { return !paused || quitting; });
+                last = Clock::now(); // time spent paused isn't emulated
+            }
+            if (quitting)
+            {
+                return;
+            }
+        }
+        Clock::time_point now = Clock::now();
+        uint64_t elapsed = std::chrono::duration_cast<std::chrono::microseconds>(now - last).count();
+        last = now;
+        next = now + period;
+        uint32_t budget = (uint32_t)std::min<uint64_t>(elapsed, MAX_SLICE_MICROS);
+        run([budget](Chip8 &chip) { return chip.runFor(budget, STOP_ON_KEY_WAIT); });
+    }
+}
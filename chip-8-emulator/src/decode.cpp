@@ -0,0 +1,113 @@
+#include "../includes/decode.h"
+
+bool isExtendedOp(OpKind kind)
+{
+    switch (kind)
+    {
+    case OP_00CN:
+    case OP_00DN:
+    case OP_00FB:
+    case OP_00FC:
+    case OP_00FD:
+    case OP_00FE:
+    case OP_00FF:
+    case OP_5XY2:
+    case OP_5XY3:
+    case OP_F000:
+    case OP_FN01:
+    case OP_F002:
+    case OP_FX30:
+    case OP_FX3A:
+    case OP_FX75:
+    case OP_FX85:
+        return true;
+    default:
+        return false;
+    }
+}
+
+OpClass opClass(OpKind kind)
+{
+    switch (kind)
+    {
+    case OP_00E0:
+    case OP_DXYN:
+    case OP_00CN:
+    case OP_00DN:
+    case OP_00FB:
+    case OP_00FC:
+    case OP_00FE:
+    case OP_00FF:
+    case OP_FN01:
+        return CLASS_DISPLAY;
+    case OP_00EE:
+    case OP_0NNN:
+    case OP_00FD:
+    case OP_1NNN:
+    case OP_2NNN:
+    case OP_BNNN:
+        return CLASS_FLOW;
+    case OP_3XNN:
+    case OP_4XNN:
+    case OP_5XY0:
+    case OP_9XY0:
+        return CLASS_SKIP;
+    case OP_EX9E:
+    case OP_EXA1:
+    case OP_FX0A:
+        return CLASS_KEY;
+    case OP_6XNN:
+    case OP_8XY0:
+    case OP_ANNN:
+    case OP_F000:
+        return CLASS_LOAD;
+    case OP_7XNN:
+    case OP_8XY1:
+    case OP_8XY2:
+    case OP_8XY3:
+    case OP_8XY4:
+    case OP_8XY5:
+    case OP_8XY6:
+    case OP_8XY7:
+    case OP_8XYE:
+    case OP_FX1E:
+        return CLASS_ALU;
+    case OP_CXNN:
+        return CLASS_RANDOM;
+    case OP_FX07:
+    case OP_FX15:
+    case OP_FX18:
+        return CLASS_TIMER;
+    case OP_FX29:
+    case OP_FX33:
+    case OP_FX55:
+    case OP_FX65:
+    case OP_FX30:
+    case OP_5XY2:
+    case OP_5XY3:
+    case OP_FX75:
+    case OP_FX85:
+        return CLASS_MEMORY;
+    case OP_F002:
+    case OP_FX3A:
+        return CLASS_AUDIO;
+    default:
+        return CLASS_OTHER;
+    }
+}
+
+const char *opClassName(OpClass group)
+{
+    static const char *const names[OP_CLASS_COUNT] = {
+        "display", "flow", "skip", "key", "load", "alu", "random", "timer", "memory", "audio", "other",
+    };
+    return group < OP_CLASS_COUNT ? names[group] : "other";
+}
+
+const char *opKindName(OpKind kind)
+{
+#define CHIP8_OP_NAME(name) #name,
+    static const char *const names[OP_KIND_COUNT] = {"decode", CHIP8_OPCODES(CHIP8_OP_NAME) "unknown"};
+#undef CHIP8_OP_NAME
+    return kind < OP_KIND_COUNT ? names[kind] : "unknown";
+}
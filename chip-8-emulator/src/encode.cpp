@@ -0,0 +1,441 @@
+#include "../includes/encode.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace
+{
+    // bits go out least significant first, as both deflate and GIF's LZW want them
+    struct BitWriter {
+        std::vector<uint8_t> &out;
+        uint32_t bits = 0;
+        int count = 0;
+
+        explicit BitWriter(std::vector<uint8_t> &out) : out(out) {}
+
+        void put(uint32_t value, int length)
+        {
+            bits |= value << count;
+            count += length;
+            while (count >= 8)
+            {
+                out.push_back(bits & 0xFF);
+                bits >>= 8;
+                count -= 8;
+            }
+        }
+
+        // Huffman codes are defined most significant bit first
+        void putCode(uint32_t code, int length)
+        {
+            uint32_t reversed = 0;
+            for (int i = 0; i < length; i++)
+            {
+                reversed = (reversed << 1) | ((code >> i) & 1);
+            }
+            put(reversed, length);
+        }
+
+        void flush()
+        {
+            if (count > 0)
+            {
+                out.push_back(bits & 0xFF);
+            }
+            bits = 0;
+            count = 0;
+        }
+    };
+
+    const uint16_t LENGTH_BASE[29] = {3,  4,  5,  6,  7,  8,  9,  10, 11,  13,  15,  17,  19,  23, 27,
+                                      31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    const uint16_t DISTANCE_BASE[30] = {1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+                                        193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    // a literal byte, end of block or length symbol, in deflate's fixed Huffman code
+    void putSymbol(BitWriter &writer, int symbol)
+    {
+        if (symbol < 144)
+        {
+            writer.putCode(0x30 + symbol, 8);
+        }
+        else if (symbol < 256)
+        {
+            writer.putCode(0x190 + symbol - 144, 9);
+        }
+        else if (symbol < 280)
+        {
+            writer.putCode(symbol - 256, 7);
+        }
+        else
+        {
+            writer.putCode(0xC0 + symbol - 280, 8);
+        }
+    }
+
+    void putMatch(BitWriter &writer, size_t length, size_t distance)
+    {
+        int code = 28;
+        while (LENGTH_BASE[code] > length)
+        {
+            code--;
+        }
+        putSymbol(writer, 257 + code);
+        writer.put(length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+        code = 29;
+        while (DISTANCE_BASE[code] > distance)
+        {
+            code--;
+        }
+        writer.putCode(code, 5);
+        writer.put(distance - DISTANCE_BASE[code], DISTANCE_EXTRA[code]);
+    }
+
+    // a zlib stream of data in one fixed-Huffman block. Matches are only tried a pixel back and a
+    // row back, which is where repeats are in a CHIP-8 frame, so no search structures are needed.
+    std::vector<uint8_t> compress(const std::vector<uint8_t> &data, size_t stride)
+    {
+        std::vector<uint8_t> out = {0x78, 0x01};
+        BitWriter writer(out);
+        writer.put(1, 1); // final block
+        writer.put(1, 2); // fixed Huffman codes
+        const size_t distances[2] = {4, stride};
+        size_t i = 0;
+        while (i < data.size())
+        {
+            size_t longest = 0;
+            size_t distance = 0;
+            size_t limit = std::min<size_t>(258, data.size() - i);
+            for (size_t candidate : distances)
+            {
+                if (candidate > i || candidate > 32768)
+                {
+                    continue;
+                }
+                size_t length = 0;
+                while (length < limit && data[i + length] == data[i + length - candidate])
+                {
+                    length++;
+                }
+                if (length > longest)
+                {
+                    longest = length;
+                    distance = candidate;
+                }
+            }
+            if (longest >= 3)
+            {
+                putMatch(writer, longest, distance);
+                i += longest;
+            }
+            else
+            {
+                putSymbol(writer, data[i++]);
+            }
+        }
+        putSymbol(writer, 256); // end of block
+        writer.flush();
+
+        uint32_t a = 1;
+        uint32_t b = 0;
+        for (uint8_t byte : data)
+        {
+            a = (a + byte) % 65521;
+            b = (b + a) % 65521;
+        }
+        uint32_t adler = b << 16 | a;
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            out.push_back(adler >> shift);
+        }
+        return out;
+    }
+
+    uint32_t crc32(const uint8_t *data, size_t size, uint32_t crc = 0)
+    {
+        static const std::array<uint32_t, 256> table = [] {
+            std::array<uint32_t, 256> entries{};
+            for (uint32_t n = 0; n < 256; n++)
+            {
+                uint32_t c = n;
+                for (int k = 0; k < 8; k++)
+                {
+                    c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+                }
+                entries[n] = c;
+            }
+            return entries;
+        }();
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++)
+        {
+            crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+    void putBE(std::vector<uint8_t> &out, uint32_t value)
+    {
+        for (int shift = 24; shift >= 0; shift -= 8)
+        {
+            out.push_back(value >> shift);
+        }
+    }
+
+    void putChunk(std::vector<uint8_t> &png, const char type[4], const std::vector<uint8_t> &data)
+    {
+        putBE(png, data.size());
+        size_t start = png.size();
+        png.insert(png.end(), type, type + 4);
+        png.insert(png.end(), data.begin(), data.end());
+        putBE(png, crc32(png.data() + start, png.size() - start));
+    }
+
+    void putLE16(std::vector<uint8_t> &out, uint32_t value)
+    {
+        out.push_back(value & 0xFF);
+        out.push_back(value >> 8);
+    }
+
+    void putLE32(std::vector<uint8_t> &out, uint32_t value)
+    {
+        putLE16(out, value & 0xFFFF);
+        putLE16(out, value >> 16);
+    }
+}
+
+std::vector<uint8_t> encodePNG(const uint32_t *pixels, int width, int height)
+{
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> header;
+    putBE(header, width);
+    putBE(header, height);
+    header.insert(header.end(), {8, 6, 0, 0, 0}); // 8-bit RGBA, deflate, no filtering, not interlaced
+    putChunk(png, "IHDR", header);
+
+    // each row is a filter type byte (0, none) and the pixels as R, G, B, A bytes
+    size_t stride = 1 + (size_t)width * 4;
+    std::vector<uint8_t> rows(stride * height);
+    for (int y = 0; y < height; y++)
+    {
+        rows[y * stride] = 0;
+        memcpy(rows.data() + y * stride + 1, pixels + (size_t)y * width, (size_t)width * 4);
+    }
+    putChunk(png, "IDAT", compress(rows, stride));
+    putChunk(png, "IEND", {});
+    return png;
+}
+
+GifWriter::~GifWriter()
+{
+    if (file != nullptr)
+    {
+        fclose(file);
+    }
+}
+
+bool GifWriter::open(const std::string &path, int imageWidth, int imageHeight, const uint32_t palette[4])
+{
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    width = imageWidth;
+    height = imageHeight;
+    previous.assign((size_t)width * height, 0);
+    first = true;
+
+    out.clear();
+    out.insert(out.end(), {'G', 'I', 'F', '8', '9', 'a'});
+    putLE16(out, width);
+    putLE16(out, height);
+    out.insert(out.end(), {0x91, 0, 0}); // a global table of 4 colours, 2 bits of colour resolution
+    for (int i = 0; i < 4; i++)
+    {
+        // RGBA words are R, G, B, A bytes in memory
+        out.insert(out.end(), {uint8_t(palette[i]), uint8_t(palette[i] >> 8), uint8_t(palette[i] >> 16)});
+    }
+    // loop forever
+    out.insert(out.end(), {0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01, 0, 0, 0});
+    return fwrite(out.data(), 1, out.size(), file) == out.size();
+}
+
+void GifWriter::addFrame(const uint8_t *indices, uint32_t delayCentiseconds)
+{
+    if (file == nullptr)
+    {
+        return;
+    }
+    // only the rows from the first to the last that changed, drawn over the frame before
+    int top = 0;
+    int bottom = height - 1;
+    if (!first)
+    {
+        while (top < height && memcmp(indices + (size_t)top * width, previous.data() + (size_t)top * width, width) == 0)
+        {
+            top++;
+        }
+        while (bottom > top && memcmp(indices + (size_t)bottom * width, previous.data() + (size_t)bottom * width, width) == 0)
+        {
+            bottom--;
+        }
+        if (top == height)
+        {
+            top = bottom = 0; // nothing changed, one row still carries the delay
+        }
+    }
+    first = false;
+    memcpy(previous.data(), indices, previous.size());
+
+    out.clear();
+    // graphic control: leave the frame in place for the next to draw over, no transparency
+    out.insert(out.end(), {0x21, 0xF9, 0x04, 0x04});
+    putLE16(out, std::min<uint32_t>(delayCentiseconds, 0xFFFF));
+    out.insert(out.end(), {0, 0});
+    writeImage(top, bottom - top + 1, indices + (size_t)top * width);
+    fwrite(out.data(), 1, out.size(), file);
+}
+
+void GifWriter::writeImage(int top, int rows, const uint8_t *indices)
+{
+    out.push_back(0x2C);
+    putLE16(out, 0);
+    putLE16(out, top);
+    putLE16(out, width);
+    putLE16(out, rows);
+    out.push_back(0); // no local colour table, not interlaced
+
+    // LZW with a 2-bit alphabet: every code's children by next index, 0 for none yet
+    const int minimumCodeSize = 2;
+    const uint32_t clearCode = 1 << minimumCodeSize;
+    std::vector<std::array<uint16_t, 4>> children(4096);
+    std::vector<uint8_t> data;
+    BitWriter writer(data);
+    int codeSize = minimumCodeSize + 1;
+    uint32_t lastCode = clearCode + 1; // end of information, the highest code in use
+    writer.put(clearCode, codeSize);
+    int current = -1;
+    size_t count = (size_t)rows * width;
+    for (size_t i = 0; i < count; i++)
+    {
+        uint8_t index = indices[i] & 3;
+        if (current < 0)
+        {
+            current = index;
+            continue;
+        }
+        if (children[current][index] != 0)
+        {
+            current = children[current][index];
+            continue;
+        }
+        writer.put(current, codeSize);
+        children[current][index] = ++lastCode;
+        if (lastCode >= (1u << codeSize))
+        {
+            codeSize++;
+        }
+        if (lastCode == 4095)
+        {
+            // table full, start over
+            writer.put(clearCode, codeSize);
+            std::fill(children.begin(), children.end(), std::array<uint16_t, 4>{});
+            codeSize = minimumCodeSize + 1;
+            lastCode = clearCode + 1;
+        }
+        current = index;
+    }
+    writer.put(current, codeSize);
+    // the decoder adds a code on reading the last one too, and may widen its codes for it
+    if (++lastCode >= (1u << codeSize))
+    {
+        codeSize++;
+    }
+    // a clear code first, so the end code is read at a size the decoder agrees on
+    writer.put(clearCode, codeSize);
+    writer.put(clearCode + 1, minimumCodeSize + 1);
+    writer.flush();
+
+    out.push_back(minimumCodeSize);
+    for (size_t start = 0; start < data.size(); start += 255)
+    {
+        size_t length = std::min<size_t>(255, data.size() - start);
+        out.push_back(length);
+        out.insert(out.end(), data.begin() + start, data.begin() + start + length);
+    }
+    out.push_back(0);
+}
+
+bool GifWriter::close()
+{
+    if (file == nullptr)
+    {
+        return false;
+    }
+    bool ok = fputc(0x3B, file) != EOF && !ferror(file);
+    ok &= fclose(file) == 0;
+    file = nullptr;
+    return ok;
+}
+
+WavWriter::~WavWriter()
+{
+    if (file != nullptr)
+    {
+        close();
+    }
+}
+
+bool WavWriter::open(const std::string &path, uint32_t sampleRate)
+{
+    file = fopen(path.c_str(), "wb");
+    if (file == nullptr)
+    {
+        return false;
+    }
+    samplesWritten = 0;
+    failed = false;
+    std::vector<uint8_t> header = {'R', 'I', 'F', 'F', 0, 0, 0, 0, 'W', 'A', 'V', 'E', 'f', 'm', 't', ' ', 16, 0, 0, 0};
+    putLE16(header, 1); // PCM
+    putLE16(header, 1); // mono
+    putLE32(header, sampleRate);
+    putLE32(header, sampleRate * 2); // bytes per second
+    putLE16(header, 2); // bytes per sample
+    putLE16(header, 16); // bits per sample
+    header.insert(header.end(), {'d', 'a', 't', 'a', 0, 0, 0, 0});
+    failed = fwrite(header.data(), 1, header.size(), file) != header.size();
+    return !failed;
+}
+
+bool WavWriter::write(const int16_t *samples, size_t count)
+{
+    if (file == nullptr)
+    {
+        return false;
+    }
+    // samples are little-endian on disk, as on every host this builds for
+    failed |= fwrite(samples, 2, count, file) != count;
+    samplesWritten += count;
+    return !failed;
+}
+
+bool WavWriter::close()
+{
+    if (file == nullptr)
+    {
+        return false;
+    }
+    std::vector<uint8_t> size;
+    uint32_t dataBytes = (uint32_t)std::min<uint64_t>(samplesWritten * 2, 0xFFFFFFFF - 36);
+    putLE32(size, dataBytes + 36);
+    failed |= fseek(file, 4, SEEK_SET) != 0 || fwrite(size.data(), 1, 4, file) != 4;
+    size.clear();
+    putLE32(size, dataBytes);
+    failed |= fseek(file, 40, SEEK_SET) != 0 || fwrite(size.data(), 1, 4, file) != 4;
+    failed |= fclose(file) != 0;
+    file = nullptr;
+    return !failed;
+}
@@ -0,0 +1,8 @@
+#include "../includes/host.h"
+#include <cstdio>
+
+void hostLog(const char *line)
+{
+    // stderr, so it never mixes with the dumps the tools print on stdout
+    fprintf(stderr, "%s\n", line);
+}
@@ -0,0 +1,16 @@
+#include "../includes/host.h"
+#include "../includes/trace.h"
+#include <emscripten.h>
+#include <cstring>
+
+void hostLog(const char *line)
+{
+#if CHIP8_TRACE_LEVEL == CHIP8_TRACE_OFF
+    (void)line; // nothing logs in these builds, leave no JS behind for it either
+#elif defined(__EMSCRIPTEN_PTHREADS__)
+    // possibly from the core's thread, which has no page: hand a copy to the page thread and carry on
+    MAIN_THREAD_ASYNC_EM_ASM({ appendLog(UTF8ToString($0)); _free($0); }, strdup(line));
+#else
+    EM_ASM({ appendLog(UTF8ToString($0)); }, line);
+#endif
+}
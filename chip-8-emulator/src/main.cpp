@@ -1,29 +1,289 @@
 #include <iostream>
 #include <cstdint>
+#include <ctime>
+#include <vector>
 #include "../includes/chip8.h"
+#include "../includes/rewind.h"
+#include "../includes/movie.h"
+#include "../includes/raster.h"
+#include "../includes/rom.h"
+#include "../includes/audio.h"
+#include "../includes/corethread.h"
 #include <emscripten.h>
 
 Chip8 chip8;
+CoreThread core(chip8); // runs chip8 on a thread of its own in THREADS=1 builds, and passes keys and frames either way
+std::vector<uint8_t> savedState; // last saveState blob, kept alive until JS has copied it out
+RewindBuffer rewindBuffer; // recent frames, recorded by the frontend while running
+RomLibrary romLibrary; // every ROM loaded this session, by content, so loading one again copies nothing
+std::shared_ptr<const RomImage> loadedROM; // kept so a recording can restart the ROM from power-on
+MovieRecorder recorder;
+std::vector<uint8_t> savedMovie; // last finished recording, kept alive until JS has copied it out
+Rasterizer rasterizer; // the published frame as RGBA, straight into an ImageData
+AudioSynth audio; // the chip's sound, drained each frame into the page's AudioWorklet
+std::vector<float> drainedAudio; // last drainAudio result, kept alive until JS has copied it out
+uint64_t rewindTick = ~0ULL; // 60 Hz tick the last rewind frame was recorded at
 
+int main() {
+    chip8.setSeed(time(0)); // a different game every page load, the runtime stays up after main returns
+    audio.attach(chip8);
+    core.setKeyHandler([](Chip8 &chip, uint8_t key, uint8_t state) {
+        recorder.keyChanged(chip, key, state); // passes the key on, and records it while recording
+    });
+    core.setSliceListener([](Chip8 &chip) {
+        audio.update(chip);
+        // a rewind frame per 60 Hz tick, however finely the time was sliced
+        uint64_t tick = chip.getCycleCount() * 60 / chip.getClockSpeed();
+        if (tick != rewindTick) {
+            rewindTick = tick;
+            rewindBuffer.record(chip);
+        }
+    });
+    return 0;
+}
 
 extern "C" { // Expose to JS
-    EMSCRIPTEN_KEEPALIVE void loadROM(uint8_t* data, size_t size) {
-        chip8.loadROM(data, size);
+    // runs the chip in real time on its own thread, so the page only has to draw. False in builds
+    // without threads, where the page keeps driving it with runFor.
+    EMSCRIPTEN_KEEPALIVE bool startCore() {
+        return core.start();
+    }
+
+    EMSCRIPTEN_KEEPALIVE void setCorePaused(bool paused) {
+        core.setPaused(paused);
+    }
+
+    // false if the ROM is empty or too large, or while recording: a movie runs the ROM it started on
+    EMSCRIPTEN_KEEPALIVE bool loadROM(uint8_t* data, size_t size) {
+        std::shared_ptr<const RomImage> rom = romLibrary.add(data, size, "ROM");
+        if (!rom) {
+            TRACE_EVENT("ERROR: ROM is empty or too large!!");
+            return false;
+        }
+        auto held = core.hold();
+        if (recorder.isRecording()) {
+            return false; // the library keeps it, loading it later copies nothing
+        }
+        loadedROM = rom;
+        chip8.loadROM(rom->data(), rom->size());
+        rewindBuffer.clear();
+        return true;
     }
 
     EMSCRIPTEN_KEEPALIVE void emulateCycle() {
-        chip8.emulateCycle();
+        core.run([](Chip8 &chip) { chip.emulateCycle(); return 0; });
+    }
+
+    EMSCRIPTEN_KEEPALIVE uint32_t runCycles(uint32_t count, uint8_t stopMask) {
+        return core.run([=](Chip8 &chip) { return chip.runCycles(count, stopMask); });
+    }
+
+    EMSCRIPTEN_KEEPALIVE uint32_t runFor(uint32_t microseconds, uint8_t stopMask) {
+        return core.run([=](Chip8 &chip) { return chip.runFor(microseconds, stopMask); });
+    }
+
+    // the AudioContext's rate, so samples play back without resampling
+    EMSCRIPTEN_KEEPALIVE void setAudioSampleRate(uint32_t hz) {
+        auto held = core.hold();
+        audio.setSampleRate(hz);
+    }
+
+    // everything synthesized since the last call as floats in [-1, 1], its length comes from getAudioSize
+    EMSCRIPTEN_KEEPALIVE const float* drainAudio() {
+        static int16_t samples[4096];
+        drainedAudio.clear();
+        size_t count;
+        while ((count = audio.read(samples, sizeof(samples) / sizeof(samples[0]))) > 0) {
+            for (size_t i = 0; i < count; i++) {
+                drainedAudio.push_back(samples[i] / 32768.0f);
+            }
+        }
+        return drainedAudio.data();
+    }
+
+    EMSCRIPTEN_KEEPALIVE size_t getAudioSize() {
+        return drainedAudio.size();
+    }
+
+    // the clock, quirks and seed are fixed for a movie when recording starts, so these return false
+    // and change nothing while recording
+    EMSCRIPTEN_KEEPALIVE bool setClockSpeed(uint32_t hz) {
+        auto held = core.hold();
+        if (recorder.isRecording()) {
+            return false;
+        }
+        chip8.setClockSpeed(hz);
+        return true;
+    }
+
+    // a QuirkProfile, for ROMs written for a particular CHIP-8 implementation
+    EMSCRIPTEN_KEEPALIVE bool setQuirks(uint8_t profile) {
+        auto held = core.hold();
+        if (recorder.isRecording()) {
+            return false;
+        }
+        chip8.setQuirks((QuirkProfile)profile);
+        return true;
+    }
+
+    EMSCRIPTEN_KEEPALIVE bool setSeed(uint32_t seed) {
+        auto held = core.hold();
+        if (recorder.isRecording()) {
+            return false;
+        }
+        chip8.setSeed(seed);
+        return true;
+    }
+
+    EMSCRIPTEN_KEEPALIVE void setBlockTranslation(bool enabled) {
+        auto held = core.hold();
+        chip8.setBlockTranslation(enabled);
     }
 
     EMSCRIPTEN_KEEPALIVE uint8_t* getDisplay() {
+        auto held = core.hold();
         return chip8.getDisplayBuffer();
     }
 
-    EMSCRIPTEN_KEEPALIVE void reset() {
+    // moves to the newest frame the core has published, false if it has shown nothing new since
+    EMSCRIPTEN_KEEPALIVE bool takeFrame() {
+        return core.takeFrame();
+    }
+
+    // the frame taken, read in place through HEAPU32 and stable until the next takeFrame
+    EMSCRIPTEN_KEEPALIVE const uint64_t* getFramePlane(int plane) {
+        return core.getFramePlane(plane);
+    }
+
+    EMSCRIPTEN_KEEPALIVE int getFrameWidth() {
+        return core.getFrameWidth();
+    }
+
+    EMSCRIPTEN_KEEPALIVE int getFrameHeight() {
+        return core.getFrameHeight();
+    }
+
+    EMSCRIPTEN_KEEPALIVE uint32_t getFrameSequence() {
+        return core.getFrameSequence();
+    }
+
+    // brings the RGBA image up to date with the frame taken and returns it, getRasterWidth() *
+    // getRasterHeight() pixels
+    EMSCRIPTEN_KEEPALIVE const uint32_t* renderFrame() {
+        return rasterizer.render(core.getFramePlane(0), core.getFramePlane(1), core.getFrameWidth() == 128, core.takeDirtyRows());
+    }
+
+    EMSCRIPTEN_KEEPALIVE int getRasterWidth() {
+        return rasterizer.getWidth();
+    }
+
+    EMSCRIPTEN_KEEPALIVE int getRasterHeight() {
+        return rasterizer.getHeight();
+    }
+
+    EMSCRIPTEN_KEEPALIVE void setRasterScale(int factor) {
+        rasterizer.setScale(factor);
+    }
+
+    EMSCRIPTEN_KEEPALIVE void setPaletteColor(int index, uint32_t rgb) {
+        rasterizer.setColor(index, rgb);
+    }
+
+    // the 64-bit mask as two 32-bit halves, low rows first, so JS needs no BigInt
+    EMSCRIPTEN_KEEPALIVE const uint32_t* takeDirtyRows() {
+        static uint32_t halves[2];
+        uint64_t rows = core.takeDirtyRows();
+        halves[0] = (uint32_t)rows;
+        halves[1] = (uint32_t)(rows >> 32);
+        return halves;
+    }
+
+    // false while recording, a movie's cycle count only ever moves forward
+    EMSCRIPTEN_KEEPALIVE bool reset() {
+        auto held = core.hold();
+        if (recorder.isRecording()) {
+            return false;
+        }
         chip8.reset();
+        rewindBuffer.clear();
+        return true;
+    }
+
+    // steps back one recorded frame, false once the history is used up
+    EMSCRIPTEN_KEEPALIVE bool rewindFrame() {
+        auto held = core.hold();
+        if (recorder.isRecording()) {
+            return false; // a movie only ever moves forward
+        }
+        return rewindBuffer.stepBack(chip8);
+    }
+
+    // restarts the loaded ROM from power-on and records every key change from there
+    EMSCRIPTEN_KEEPALIVE void startRecording() {
+        auto held = core.hold();
+        recorder.start(chip8, loadedROM ? loadedROM->data() : nullptr, loadedROM ? loadedROM->size() : 0, chip8.getSeed());
+        rewindBuffer.clear();
+    }
+
+    // returns the movie file, its length comes from getMovieSize
+    EMSCRIPTEN_KEEPALIVE const uint8_t* stopRecording() {
+        auto held = core.hold();
+        savedMovie = saveMovie(recorder.finish(chip8));
+        return savedMovie.data();
+    }
+
+    EMSCRIPTEN_KEEPALIVE size_t getMovieSize() {
+        return savedMovie.size();
+    }
+
+    EMSCRIPTEN_KEEPALIVE void setRewindBudget(size_t bytes) {
+        auto held = core.hold();
+        rewindBuffer.setBudget(bytes);
     }
 
     EMSCRIPTEN_KEEPALIVE void setKeyState(uint8_t key, uint8_t state) {
-        chip8.setKeyState(key, state);
+        core.setKeyState(key, state); // never waits for the core, which picks it up at its next slice
+    }
+
+    // copied out, the core may be appending to its buffer again as soon as it's let go
+    EMSCRIPTEN_KEEPALIVE const char* drainTrace() {
+        static std::string drained;
+        auto held = core.hold();
+        drained = chip8.drainTrace();
+        return drained.c_str();
+    }
+
+    // flat profile, or with stacks set the collapsed call stacks. Empty unless built with PROFILE=1.
+    EMSCRIPTEN_KEEPALIVE const char* getProfile(int stacks) {
+        static std::string profile;
+        auto held = core.hold();
+        profile = stacks ? chip8.getProfileStacks() : chip8.getProfileReport();
+        return profile.c_str();
+    }
+
+    EMSCRIPTEN_KEEPALIVE void clearProfile() {
+        auto held = core.hold();
+        chip8.clearProfile();
+    }
+
+    // returns the blob, its length comes from getSavedStateSize
+    EMSCRIPTEN_KEEPALIVE const uint8_t* saveState() {
+        auto held = core.hold();
+        savedState = chip8.saveState();
+        return savedState.data();
+    }
+
+    EMSCRIPTEN_KEEPALIVE size_t getSavedStateSize() {
+        return savedState.size();
+    }
+
+    // false while recording too, a movie can't reproduce a jump to another state
+    EMSCRIPTEN_KEEPALIVE bool loadState(const uint8_t* data, size_t size) {
+        auto held = core.hold();
+        if (recorder.isRecording() || !chip8.loadState(data, size)) {
+            return false;
+        }
+        rewindBuffer.clear(); // its frames lead back to the machine before the load
+        return true;
     }
 }
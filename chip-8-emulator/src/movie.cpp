@@ -0,0 +1,181 @@
+#include "../includes/movie.h"
+#include "../includes/bytes.h"
+#include "../includes/chip8.h"
+#include <algorithm>
+#include <cstring>
+
+// movie layout, version 2, integers little-endian unless noted:
+//   magic "C8MV", u16 version, u64 ROM hash, u64 seed, u32 clock speed, u8 quirk profile,
+//   u64 length in cycles, u64 display hash, varint key event count,
+//   per event: varint cycles since the previous event, u8 state << 4 | key
+// version 1 is the same without the quirk profile, those movies were all recorded on QUIRKS_DEFAULT
+
+uint64_t hashROM(const uint8_t *data, size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::vector<uint8_t> saveMovie(const Movie &movie)
+{
+    std::vector<uint8_t> out(MOVIE_MAGIC, MOVIE_MAGIC + sizeof(MOVIE_MAGIC));
+    putLE(out, MOVIE_VERSION, 2);
+    putLE(out, movie.romHash, 8);
+    putLE(out, movie.seed, 8);
+    putLE(out, movie.clockSpeed, 4);
+    putLE(out, movie.quirks, 1);
+    putLE(out, movie.length, 8);
+    putLE(out, movie.displayHash, 8);
+    putVarint(out, movie.keys.size());
+    uint64_t previous = 0;
+    for (const KeyEvent &event : movie.keys)
+    {
+        putVarint(out, event.cycle - previous);
+        out.push_back((event.state << 4) | event.key);
+        previous = event.cycle;
+    }
+    return out;
+}
+
+bool loadMovie(const uint8_t *data, size_t size, Movie &movie, std::string &error)
+{
+    if (size < sizeof(MOVIE_MAGIC) || memcmp(data, MOVIE_MAGIC, sizeof(MOVIE_MAGIC)) != 0)
+    {
+        error = "not a movie";
+        return false;
+    }
+    ByteReader in(data + sizeof(MOVIE_MAGIC), size - sizeof(MOVIE_MAGIC));
+    uint16_t version = in.getLE(2);
+    if (in.ok && (version == 0 || version > MOVIE_VERSION))
+    {
+        error = "movie version " + std::to_string(version) + " is not supported";
+        return false;
+    }
+    Movie loaded;
+    loaded.romHash = in.getLE(8);
+    loaded.seed = in.getLE(8);
+    loaded.clockSpeed = in.getLE(4);
+    uint8_t quirks = version >= 2 ? in.getLE(1) : (uint64_t)QUIRKS_DEFAULT;
+    loaded.quirks = (QuirkProfile)quirks;
+    loaded.length = in.getLE(8);
+    loaded.displayHash = in.getLE(8);
+    uint64_t count = in.getVarint();
+    // every event takes at least two bytes, don't trust a count the data can't hold
+    if (!in.ok || count > in.remaining() / 2 || loaded.clockSpeed == 0 || quirks >= QUIRK_PROFILE_COUNT)
+    {
+        error = "movie header is corrupt";
+        return false;
+    }
+    loaded.keys.reserve(count);
+    uint64_t cycle = 0;
+    for (uint64_t i = 0; i < count && in.ok; i++)
+    {
+        cycle += in.getVarint();
+        uint8_t packed = in.getLE(1);
+        if ((packed >> 4) > 1 || cycle > loaded.length)
+        {
+            in.ok = false;
+        }
+        loaded.keys.push_back({cycle, (uint8_t)(packed & 0x0F), (uint8_t)(packed >> 4)});
+    }
+    if (!in.ok || in.remaining() != 0)
+    {
+        error = "movie key events are corrupt";
+        return false;
+    }
+    movie = std::move(loaded);
+    return true;
+}
+
+// power-on state for a recording or replay: reset with the seed in place, then the ROM
+static void powerOn(Chip8 &chip8, const uint8_t *rom, size_t size, uint64_t seed)
+{
+    chip8.setSeed(seed);
+    chip8.reset();
+    chip8.loadROM(rom, size);
+}
+
+void MovieRecorder::start(Chip8 &chip8, const uint8_t *rom, size_t size, uint64_t seed)
+{
+    powerOn(chip8, rom, size, seed);
+    movie = Movie();
+    movie.romHash = hashROM(rom, size);
+    movie.seed = seed;
+    movie.clockSpeed = chip8.getClockSpeed();
+    movie.quirks = chip8.getQuirks();
+    keyStates.fill(0);
+    recording = true;
+}
+
+void MovieRecorder::keyChanged(Chip8 &chip8, uint8_t key, uint8_t state)
+{
+    key &= 0x0F;
+    state = state != 0;
+    chip8.setKeyState(key, state);
+    // held keys auto-repeat in most hosts, only actual changes are worth storing
+    if (recording && keyStates[key] != state)
+    {
+        keyStates[key] = state;
+        movie.keys.push_back({chip8.getCycleCount(), key, state});
+    }
+}
+
+Movie MovieRecorder::finish(const Chip8 &chip8)
+{
+    recording = false;
+    movie.length = chip8.getCycleCount();
+    movie.displayHash = chip8.getDisplayHash();
+    return movie;
+}
+
+bool MoviePlayer::start(Chip8 &chip8, const Movie &recorded, const uint8_t *rom, size_t size)
+{
+    if (hashROM(rom, size) != recorded.romHash)
+    {
+        TRACE_EVENT("ERROR: movie was recorded on a different ROM");
+        return false;
+    }
+    chip8.setClockSpeed(recorded.clockSpeed);
+    chip8.setQuirks(recorded.quirks);
+    powerOn(chip8, rom, size, recorded.seed);
+    movie = &recorded;
+    nextKey = 0;
+    return true;
+}
+
+uint64_t MoviePlayer::run(Chip8 &chip8, uint64_t cycles)
+{
+    uint64_t start = chip8.getCycleCount();
+    uint64_t end = std::min(movie->length, start + cycles);
+    uint64_t now = start;
+    for (;;)
+    {
+        // keys change between instructions, exactly where the recording saw them change
+        while (nextKey < movie->keys.size() && movie->keys[nextKey].cycle <= now)
+        {
+            const KeyEvent &event = movie->keys[nextKey++];
+            chip8.setKeyState(event.key, event.state);
+        }
+        if (now >= end)
+        {
+            return now - start;
+        }
+        uint64_t until = end;
+        if (nextKey < movie->keys.size())
+        {
+            until = std::min(until, movie->keys[nextKey].cycle);
+        }
+        chip8.runCycles(std::min<uint64_t>(until - now, 1000000)); // a key wait idles out the rest
+        now = chip8.getCycleCount();
+    }
+}
+
+bool MoviePlayer::isFinished(const Chip8 &chip8) const
+{
+    return movie == nullptr || chip8.getCycleCount() >= movie->length;
+}
@@ -0,0 +1,153 @@
+#include "../includes/profile.h"
+#include "../includes/chip8.h"
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+
+Profiler::Profiler()
+{
+    clear();
+}
+
+void Profiler::enterContext(const uint16_t *stack, uint8_t depth, const uint8_t *memory)
+{
+    // walk down from the top level, one frame per return address. A return address points just
+    // past its 2NNN, so the callee can be read back from the call itself.
+    uint32_t node = 0;
+    for (uint8_t i = 0; i < depth; i++)
+    {
+        uint16_t call = (stack[i] - 2) & 0x0FFF;
+        uint16_t opcode = (memory[call] << 8) | memory[(call + 1) & 0x0FFF];
+        bool direct = (opcode & 0xF000) == 0x2000;
+        uint16_t entry = direct ? opcode & 0x0FFF : call;
+        uint64_t key = (uint64_t)node << 17 | (uint64_t)direct << 16 | entry;
+        auto found = children.find(key);
+        if (found != children.end())
+        {
+            node = found->second;
+            continue;
+        }
+        contexts.push_back({node, entry, direct});
+        contextCounts.push_back(0);
+        node = contexts.size() - 1;
+        children.emplace(key, node);
+    }
+    context = node;
+}
+
+void Profiler::clear()
+{
+    kindCounts.fill(0);
+    pcCounts.fill(0);
+    keyWaitCycles = 0;
+    draws = 0;
+    drawNanos = 0;
+    contexts.assign(1, {0, 0, true});
+    contextCounts.assign(1, 0);
+    children.clear();
+    context = 0; // the stack is rebuilt on the next call or return
+}
+
+static std::string format(const char *pattern, ...) __attribute__((format(printf, 1, 2)));
+
+static std::string format(const char *pattern, ...)
+{
+    char line[160];
+    va_list args;
+    va_start(args, pattern);
+    vsnprintf(line, sizeof(line), pattern, args);
+    va_end(args);
+    return line;
+}
+
+static double percent(uint64_t part, uint64_t whole)
+{
+    return whole > 0 ? 100.0 * part / whole : 0.0;
+}
+
+std::string Profiler::report(const uint8_t *memory, bool extended) const
+{
+    uint64_t total = 0;
+    for (uint64_t count : kindCounts)
+    {
+        total += count;
+    }
+    std::string out;
+    out += format("cycles      %llu\n", (unsigned long long)total);
+    out += format("key wait    %llu cycles (%.1f%%)\n", (unsigned long long)keyWaitCycles, percent(keyWaitCycles, total));
+    out += format("draws       %llu, %.3f ms drawing, %.0f ns each\n", (unsigned long long)draws, drawNanos / 1e6,
+                  draws > 0 ? (double)drawNanos / draws : 0.0);
+
+    std::array<uint64_t, OP_CLASS_COUNT> classCounts{};
+    for (int kind = 0; kind < OP_KIND_COUNT; kind++)
+    {
+        classCounts[opClass((OpKind)kind)] += kindCounts[kind];
+    }
+    out += "\nclass           cycles       %\n";
+    for (int group = 0; group < OP_CLASS_COUNT; group++)
+    {
+        if (classCounts[group] > 0)
+        {
+            out += format("%-8s %13llu  %6.2f\n", opClassName((OpClass)group), (unsigned long long)classCounts[group],
+                          percent(classCounts[group], total));
+        }
+    }
+
+    out += "\nopcode          cycles       %\n";
+    for (int kind = 0; kind < OP_KIND_COUNT; kind++)
+    {
+        if (kindCounts[kind] > 0)
+        {
+            out += format("%-8s %13llu  %6.2f\n", opKindName((OpKind)kind), (unsigned long long)kindCounts[kind],
+                          percent(kindCounts[kind], total));
+        }
+    }
+
+    // hottest addresses, with what is there now (self-modifying code may have run something else)
+    std::vector<uint16_t> addresses;
+    for (uint16_t address = 0; address < pcCounts.size(); address++)
+    {
+        if (pcCounts[address] > 0)
+        {
+            addresses.push_back(address);
+        }
+    }
+    std::sort(addresses.begin(), addresses.end(), [this](uint16_t a, uint16_t b) {
+        return pcCounts[a] != pcCounts[b] ? pcCounts[a] > pcCounts[b] : a < b;
+    });
+    addresses.resize(std::min<size_t>(addresses.size(), 32));
+    out += "\naddress  opcode        cycles       %\n";
+    for (uint16_t address : addresses)
+    {
+        uint16_t opcode = (memory[address] << 8) | memory[(address + 1) & 0x0FFF];
+        out += format("0x%03X    %04X %-4s %11llu  %6.2f\n", address, opcode, opKindName(Chip8::decode(opcode, extended).kind),
+                      (unsigned long long)pcCounts[address], percent(pcCounts[address], total));
+    }
+    return out;
+}
+
+std::string Profiler::collapsed() const
+{
+    std::string out;
+    std::vector<uint32_t> path;
+    for (uint32_t node = 0; node < contexts.size(); node++)
+    {
+        if (contextCounts[node] == 0)
+        {
+            continue;
+        }
+        path.clear();
+        for (uint32_t frame = node; frame != 0; frame = contexts[frame].parent)
+        {
+            path.push_back(frame);
+        }
+        std::string line = "main";
+        for (auto frame = path.rbegin(); frame != path.rend(); ++frame)
+        {
+            const Context &called = contexts[*frame];
+            line += format(called.direct ? ";sub_%03X" : ";call@%03X", called.entry);
+        }
+        out += line + format(" %llu\n", (unsigned long long)contextCounts[node]);
+    }
+    return out;
+}
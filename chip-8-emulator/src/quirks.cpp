@@ -0,0 +1,50 @@
+#include "../includes/quirks.h"
+#include <cstring>
+
+static const char *const profileNames[QUIRK_PROFILE_COUNT] = {"default", "cosmac-vip", "chip-48", "super-chip", "xo-chip"};
+
+const char *quirkProfileName(QuirkProfile profile)
+{
+    return profile < QUIRK_PROFILE_COUNT ? profileNames[profile] : "default";
+}
+
+uint32_t quirkMemorySize(QuirkProfile profile)
+{
+    switch (profile)
+    {
+#define CHIP8_MEMORY_SIZE(name)                                                                                         \
+    case QUIRKS_##name:                                                                                                 \
+        return Quirks<QUIRKS_##name>::memoryMask + 1;
+        CHIP8_QUIRK_PROFILES(CHIP8_MEMORY_SIZE)
+#undef CHIP8_MEMORY_SIZE
+    default:
+        return Quirks<QUIRKS_DEFAULT>::memoryMask + 1;
+    }
+}
+
+bool quirkExtended(QuirkProfile profile)
+{
+    switch (profile)
+    {
+#define CHIP8_EXTENDED(name)                                                                                            \
+    case QUIRKS_##name:                                                                                                 \
+        return Quirks<QUIRKS_##name>::extended;
+        CHIP8_QUIRK_PROFILES(CHIP8_EXTENDED)
+#undef CHIP8_EXTENDED
+    default:
+        return Quirks<QUIRKS_DEFAULT>::extended;
+    }
+}
+
+bool parseQuirkProfile(const char *name, QuirkProfile &profile)
+{
+    for (int i = 0; i < QUIRK_PROFILE_COUNT; i++)
+    {
+        if (strcmp(name, profileNames[i]) == 0)
+        {
+            profile = (QuirkProfile)i;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,167 @@
+#include "../includes/raster.h"
+#include "../includes/chip8.h"
+#include <algorithm>
+#include <cstring>
+
+#if CHIP8_SIMD
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#endif
+#endif
+
+namespace
+{
+#if CHIP8_SIMD
+    // the few 4 x u32 operations the kernels need, on each instruction set
+#if defined(__SSE2__)
+    typedef __m128i Lanes;
+    inline Lanes splat(uint32_t value) { return _mm_set1_epi32((int)value); }
+    inline Lanes lanes(uint32_t a, uint32_t b, uint32_t c, uint32_t d) { return _mm_setr_epi32(a, b, c, d); }
+    // all ones in each lane where bits has the lane's single mask bit set
+    inline Lanes isSet(Lanes bits, Lanes mask) { return _mm_cmpeq_epi32(_mm_and_si128(bits, mask), mask); }
+    // a where mask is set, b elsewhere
+    inline Lanes select(Lanes mask, Lanes a, Lanes b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+    inline void store(uint32_t *out, Lanes value) { _mm_storeu_si128((__m128i *)out, value); }
+#elif defined(__ARM_NEON)
+    typedef uint32x4_t Lanes;
+    inline Lanes splat(uint32_t value) { return vdupq_n_u32(value); }
+    inline Lanes lanes(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+    {
+        const uint32_t values[4] = {a, b, c, d};
+        return vld1q_u32(values);
+    }
+    inline Lanes isSet(Lanes bits, Lanes mask) { return vtstq_u32(bits, mask); }
+    inline Lanes select(Lanes mask, Lanes a, Lanes b) { return vbslq_u32(mask, a, b); }
+    inline void store(uint32_t *out, Lanes value) { vst1q_u32(out, value); }
+#elif defined(__wasm_simd128__)
+    typedef v128_t Lanes;
+    inline Lanes splat(uint32_t value) { return wasm_i32x4_splat((int32_t)value); }
+    inline Lanes lanes(uint32_t a, uint32_t b, uint32_t c, uint32_t d) { return wasm_u32x4_make(a, b, c, d); }
+    inline Lanes isSet(Lanes bits, Lanes mask) { return wasm_i32x4_eq(wasm_v128_and(bits, mask), mask); }
+    inline Lanes select(Lanes mask, Lanes a, Lanes b) { return wasm_v128_bitselect(a, b, mask); }
+    inline void store(uint32_t *out, Lanes value) { wasm_v128_store(out, value); }
+#endif
+#endif
+
+    // colours one display row, words 64-pixel words per plane, into out at one pixel per pixel
+    void colorRow(const uint64_t *first, const uint64_t *second, int words, const uint32_t *palette, uint32_t *out)
+    {
+#if CHIP8_SIMD
+        // four pixels at a time: each lane tests its pixel's bit on both planes, then two bitwise
+        // selects pick its palette entry without a lookup
+        const Lanes order = lanes(8, 4, 2, 1); // the leftmost of the four is the highest bit
+        const Lanes colors[4] = {splat(palette[0]), splat(palette[1]), splat(palette[2]), splat(palette[3])};
+        for (int w = 0; w < words; w++)
+        {
+            for (int shift = 60; shift >= 0; shift -= 4)
+            {
+                Lanes onFirst = isSet(splat((first[w] >> shift) & 0xF), order);
+                Lanes onSecond = isSet(splat((second[w] >> shift) & 0xF), order);
+                store(out, select(onSecond, select(onFirst, colors[3], colors[2]), select(onFirst, colors[1], colors[0])));
+                out += 4;
+            }
+        }
+#else
+        for (int w = 0; w < words; w++)
+        {
+            for (int bit = 63; bit >= 0; bit--)
+            {
+                *out++ = palette[((first[w] >> bit) & 1) | ((second[w] >> bit) & 1) << 1];
+            }
+        }
+#endif
+    }
+
+    // repeats every pixel of in scale times across out, which has room for 3 pixels past the end
+    void widenRow(const uint32_t *in, int count, int scale, uint32_t *out)
+    {
+        for (int x = 0; x < count; x++)
+        {
+#if CHIP8_SIMD
+            // whole vectors of the colour, the next pixel overwrites whatever spilt past this one
+            Lanes color = splat(in[x]);
+            for (int i = 0; i < scale; i += 4)
+            {
+                store(out + i, color);
+            }
+#else
+            std::fill_n(out, scale, in[x]);
+#endif
+            out += scale;
+        }
+    }
+}
+
+Rasterizer::Rasterizer()
+{
+    // black, green for the first plane, red for the second and yellow where they overlap
+    setColor(0, 0x000000);
+    setColor(1, 0x00FF00);
+    setColor(2, 0xFF0000);
+    setColor(3, 0xFFFF00);
+}
+
+void Rasterizer::setScale(int factor)
+{
+    factor = std::min(std::max(factor, 1), MAX_SCALE);
+    stale |= factor != scale;
+    scale = factor;
+}
+
+void Rasterizer::setColor(int index, uint32_t rgb)
+{
+    if (index < 0 || index > 3)
+    {
+        return;
+    }
+    // R, G, B, A in memory order is ABGR in a little-endian word
+    uint32_t color = 0xFF000000 | (rgb & 0xFF) << 16 | (rgb & 0xFF00) | (rgb >> 16 & 0xFF);
+    stale |= color != palette[index];
+    palette[index] = color;
+}
+
+const uint32_t *Rasterizer::render(const Chip8 &chip8, uint64_t rows)
+{
+    return render(chip8.getFramePlane(0), chip8.getFramePlane(1), chip8.getFrameWidth() == DISPLAY_MAX_WIDTH, rows);
+}
+
+const uint32_t *Rasterizer::render(const uint64_t *first, const uint64_t *second, bool hires, uint64_t rows)
+{
+    int frameWidth = hires ? 128 : 64;
+    int frameHeight = hires ? 64 : 32;
+    if (stale || frameWidth * scale != width || frameHeight * scale != height)
+    {
+        width = frameWidth * scale;
+        height = frameHeight * scale;
+        pixels.assign((size_t)width * height, 0);
+        line.assign(frameWidth, 0);
+        wideLine.assign(width + 3, 0);
+        rows = ~0ULL;
+        stale = false;
+    }
+    int words = frameWidth / 64;
+    for (int y = 0; y < frameHeight; y++)
+    {
+        if (!((rows >> y) & 1))
+        {
+            continue;
+        }
+        uint32_t *out = pixels.data() + (size_t)y * scale * width;
+        if (scale == 1)
+        {
+            colorRow(first + y * DISPLAY_ROW_WORDS, second + y * DISPLAY_ROW_WORDS, words, palette, out);
+            continue;
+        }
+        colorRow(first + y * DISPLAY_ROW_WORDS, second + y * DISPLAY_ROW_WORDS, words, palette, line.data());
+        widenRow(line.data(), frameWidth, scale, wideLine.data());
+        for (int copy = 0; copy < scale; copy++)
+        {
+            memcpy(out + (size_t)copy * width, wideLine.data(), width * sizeof(uint32_t));
+        }
+    }
+    return pixels.data();
+}
@@ -0,0 +1,124 @@
+// chip8-replay: plays recorded movies back headless, in parallel, and checks each one still ends on
+// the display it was recorded with. The ROM for every movie is found by hash in a ROM directory.
+// Prints one line per movie and exits with 1 if any movie failed.
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../includes/batch.h"
+#include "../includes/movie.h"
+#include "../includes/rom.h"
+
+static void usage()
+{
+    fprintf(stderr,
+            "usage: chip8-replay [options] <movie.c8m>...\n"
+            "  --roms DIR    where to look for the ROMs the movies were recorded on (default roms)\n"
+            "  --threads N   worker threads (default: one per hardware thread)\n");
+}
+
+int main(int argc, char **argv)
+{
+    std::string romDirectory = "roms";
+    unsigned threads = 0;
+    std::vector<std::string> moviePaths;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--roms" && i + 1 < argc)
+        {
+            romDirectory = argv[++i];
+        }
+        else if (arg == "--threads" && i + 1 < argc)
+        {
+            threads = strtoul(argv[++i], nullptr, 10);
+        }
+        else if (arg[0] == '-')
+        {
+            usage();
+            return arg == "--help" ? 0 : 2;
+        }
+        else
+        {
+            moviePaths.push_back(arg);
+        }
+    }
+    if (moviePaths.empty())
+    {
+        usage();
+        return 2;
+    }
+
+    // every ROM we know, read only once a movie asks for its hash
+    RomLibrary library;
+    library.addDirectory(romDirectory);
+
+    std::vector<BatchJob> jobs;
+    std::vector<Movie> movies;
+    std::vector<std::string> problems; // per job, empty if it could be replayed
+    for (const std::string &path : moviePaths)
+    {
+        std::ifstream file(path, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        Movie movie;
+        std::string error;
+        BatchJob job;
+        job.name = path;
+        if (!file && data.empty())
+        {
+            error = "cannot open";
+        }
+        else if (loadMovie(data.data(), data.size(), movie, error))
+        {
+            job.rom = library.find(movie.romHash);
+            if (!job.rom)
+            {
+                error = "ROM not found in " + romDirectory;
+            }
+            else
+            {
+                job.keys = movie.keys;
+                job.cycles = movie.length;
+                job.clockSpeed = movie.clockSpeed;
+                job.seed = movie.seed;
+                job.quirks = movie.quirks;
+            }
+        }
+        jobs.push_back(std::move(job));
+        movies.push_back(movie);
+        problems.push_back(error);
+    }
+
+    BatchRunner runner(threads);
+    std::vector<BatchResult> results = runner.run(jobs);
+
+    int failed = 0;
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        const char *path = jobs[i].name.c_str();
+        if (!problems[i].empty())
+        {
+            printf("FAIL %s: %s\n", path, problems[i].c_str());
+            failed++;
+        }
+        else if (movies[i].displayHash == 0)
+        {
+            printf("DONE %s: display %016llx after %llu cycles (no recorded display to compare)\n", path,
+                   (unsigned long long)results[i].framebufferHash, (unsigned long long)movies[i].length);
+        }
+        else if (results[i].framebufferHash != movies[i].displayHash)
+        {
+            printf("FAIL %s: display %016llx, recorded %016llx\n", path,
+                   (unsigned long long)results[i].framebufferHash, (unsigned long long)movies[i].displayHash);
+            failed++;
+        }
+        else
+        {
+            printf("OK   %s\n", path);
+        }
+    }
+    return failed == 0 ? 0 : 1;
+}
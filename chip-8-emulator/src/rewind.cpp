@@ -0,0 +1,135 @@
+#include "../includes/rewind.h"
+#include "../includes/chip8.h"
+#include "../includes/bytes.h"
+#include <algorithm>
+#include <cstring>
+
+// deltas are a sequence of (unchanged byte count, changed byte count, changed bytes XOR old) runs,
+// with both counts as LEB128 varints. States differ in length when the resolution, the planes drawn
+// or the quirk profile change; the shorter one is taken as zero-padded to the longer.
+namespace
+{
+    void encodeDelta(const std::vector<uint8_t> &from, const std::vector<uint8_t> &to, std::vector<uint8_t> &out)
+    {
+        out.clear();
+        size_t size = std::max(from.size(), to.size());
+        auto at = [](const std::vector<uint8_t> &state, size_t i) -> uint8_t { return i < state.size() ? state[i] : 0; };
+        size_t i = 0;
+        while (i < size)
+        {
+            size_t same = i;
+            while (same < size && at(from, same) == at(to, same))
+            {
+                same++;
+            }
+            // a lone equal byte between two changes is cheaper kept inside the changed run
+            size_t changed = same;
+            while (changed < size && (at(from, changed) != at(to, changed) ||
+                                      (changed + 1 < size && at(from, changed + 1) != at(to, changed + 1))))
+            {
+                changed++;
+            }
+            putVarint(out, same - i);
+            putVarint(out, changed - same);
+            for (size_t j = same; j < changed; j++)
+            {
+                out.push_back(at(from, j) ^ at(to, j));
+            }
+            i = changed;
+        }
+    }
+
+    // XORs the delta back into state, which turns either neighbour into the other
+    void applyDelta(const std::vector<uint8_t> &delta, std::vector<uint8_t> &state)
+    {
+        ByteReader in(delta.data(), delta.size());
+        size_t i = 0;
+        while (in.remaining() > 0)
+        {
+            i += in.getVarint();
+            size_t changed = in.getVarint();
+            for (size_t j = 0; j < changed; j++)
+            {
+                state[i++] ^= *in.data++;
+            }
+        }
+    }
+}
+
+RewindBuffer::RewindBuffer(size_t budgetBytes)
+{
+    setBudget(budgetBytes);
+}
+
+void RewindBuffer::setBudget(size_t budgetBytes)
+{
+    ring.assign(budgetBytes, 0);
+    clear();
+}
+
+void RewindBuffer::clear()
+{
+    deltas.clear();
+    used = 0;
+    newest.clear();
+}
+
+size_t RewindBuffer::getFrameCount() const
+{
+    return newest.empty() ? 0 : deltas.size() + 1;
+}
+
+void RewindBuffer::record(const Chip8 &chip8)
+{
+    std::vector<uint8_t> state = chip8.saveState();
+    if (!newest.empty())
+    {
+        encodeDelta(newest, state, scratch);
+        append(scratch, newest.size());
+    }
+    newest.swap(state);
+}
+
+void RewindBuffer::append(const std::vector<uint8_t> &delta, size_t stateSize)
+{
+    if (delta.size() > ring.size())
+    {
+        // bigger than the whole budget, nothing older can be kept
+        deltas.clear();
+        used = 0;
+        return;
+    }
+    while (used + delta.size() > ring.size())
+    {
+        used -= deltas.front().length;
+        deltas.pop_front();
+    }
+    size_t offset = deltas.empty() ? 0 : (deltas.back().offset + deltas.back().length) % ring.size();
+    size_t first = std::min(delta.size(), ring.size() - offset);
+    memcpy(ring.data() + offset, delta.data(), first);
+    memcpy(ring.data(), delta.data() + first, delta.size() - first);
+    deltas.push_back({offset, delta.size(), stateSize});
+    used += delta.size();
+}
+
+bool RewindBuffer::stepBack(Chip8 &chip8)
+{
+    if (deltas.empty())
+    {
+        return false;
+    }
+    Delta delta = deltas.back();
+    deltas.pop_back();
+    used -= delta.length;
+
+    // copy the delta out of the ring in one piece, it may wrap around the end
+    scratch.resize(delta.length);
+    size_t first = std::min(delta.length, ring.size() - delta.offset);
+    memcpy(scratch.data(), ring.data() + delta.offset, first);
+    memcpy(scratch.data() + first, ring.data(), delta.length - first);
+
+    newest.resize(std::max(newest.size(), delta.stateSize), 0);
+    applyDelta(scratch, newest);
+    newest.resize(delta.stateSize);
+    return chip8.loadState(newest.data(), newest.size());
+}
@@ -0,0 +1,180 @@
+#include "../includes/rom.h"
+#include "../includes/movie.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#define CHIP8_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define CHIP8_MMAP 0
+#endif
+
+namespace
+{
+    bool checkSize(const std::string &path, size_t size, std::string &error)
+    {
+        if (size == 0)
+        {
+            error = path + " is empty";
+            return false;
+        }
+        if (size > MAX_ROM_SIZE)
+        {
+            error = path + " is too large (" + std::to_string(size) + " bytes, at most " + std::to_string(MAX_ROM_SIZE) + ")";
+            return false;
+        }
+        return true;
+    }
+}
+
+bool readROMFile(const std::string &path, std::vector<uint8_t> &data, std::string &error)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+    {
+        error = "cannot open " + path;
+        return false;
+    }
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return checkSize(path, data.size(), error);
+}
+
+RomImage::RomImage(std::vector<uint8_t> contents, const std::string &name)
+    : owned(std::move(contents)), bytes(owned.data()), length(owned.size()), mapped(false), hash(hashROM(owned.data(), owned.size())), name(name)
+{
+}
+
+RomImage::RomImage(const uint8_t *mapping, size_t size, const std::string &name)
+    : bytes(mapping), length(size), mapped(true), hash(hashROM(mapping, size)), name(name)
+{
+}
+
+RomImage::~RomImage()
+{
+#if CHIP8_MMAP
+    if (mapped)
+    {
+        munmap((void *)bytes, length);
+    }
+#endif
+}
+
+std::shared_ptr<const RomImage> RomLibrary::open(const std::string &path, std::string &error)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return load(path, error);
+}
+
+std::shared_ptr<const RomImage> RomLibrary::add(const uint8_t *data, size_t size, const std::string &name)
+{
+    std::string error;
+    if (!checkSize(name, size, error))
+    {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    auto known = images.find(hashROM(data, size));
+    if (known != images.end() && known->second->size() == size && memcmp(known->second->data(), data, size) == 0)
+    {
+        return known->second; // seen before, no copy needed
+    }
+    return share(std::make_shared<const RomImage>(std::vector<uint8_t>(data, data + size), name));
+}
+
+void RomLibrary::addDirectory(const std::string &directory)
+{
+    std::vector<std::string> found;
+    std::error_code listError;
+    for (const auto &entry : std::filesystem::directory_iterator(directory, listError))
+    {
+        if (entry.is_regular_file())
+        {
+            found.push_back(entry.path().string());
+        }
+    }
+    std::lock_guard<std::mutex> guard(lock);
+    unopened.insert(unopened.end(), found.begin(), found.end());
+}
+
+std::shared_ptr<const RomImage> RomLibrary::find(uint64_t hash)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    // read directory entries only until one matches, the rest stay unread for later lookups
+    while (images.count(hash) == 0 && !unopened.empty())
+    {
+        std::string path = unopened.back();
+        unopened.pop_back();
+        std::string error;
+        load(path, error); // files that aren't ROMs just can't match
+    }
+    auto known = images.find(hash);
+    return known != images.end() ? known->second : nullptr;
+}
+
+std::shared_ptr<const RomImage> RomLibrary::load(const std::string &path, std::string &error)
+{
+    auto opened = paths.find(path);
+    if (opened != paths.end())
+    {
+        return opened->second;
+    }
+    std::string name = std::filesystem::path(path).filename().string();
+    std::shared_ptr<const RomImage> image;
+#if CHIP8_MMAP
+    int file = ::open(path.c_str(), O_RDONLY);
+    struct stat info;
+    if (file < 0 || fstat(file, &info) != 0)
+    {
+        if (file >= 0)
+        {
+            close(file);
+        }
+        error = "cannot open " + path;
+        return nullptr;
+    }
+    if (!checkSize(path, info.st_size, error))
+    {
+        close(file);
+        return nullptr;
+    }
+    void *mapping = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file); // the mapping keeps the file open
+    if (mapping == MAP_FAILED)
+    {
+        error = "cannot map " + path;
+        return nullptr;
+    }
+    image = std::make_shared<const RomImage>((const uint8_t *)mapping, (size_t)info.st_size, name);
+#else
+    std::vector<uint8_t> data;
+    if (!readROMFile(path, data, error))
+    {
+        return nullptr;
+    }
+    image = std::make_shared<const RomImage>(std::move(data), name);
+#endif
+    image = share(image);
+    paths[path] = image;
+    return image;
+}
+
+std::shared_ptr<const RomImage> RomLibrary::share(std::shared_ptr<const RomImage> image)
+{
+    auto known = images.find(image->getHash());
+    if (known == images.end())
+    {
+        images[image->getHash()] = image;
+        return image;
+    }
+    if (known->second->size() == image->size() && memcmp(known->second->data(), image->data(), image->size()) == 0)
+    {
+        return known->second; // the new copy is freed or unmapped as it goes out of scope
+    }
+    return image; // a hash collision, keep them apart and leave the first one cached
+}
@@ -0,0 +1,311 @@
+// chip8-run: headless native runner. Loads a ROM, runs it for a number of cycles or 60 Hz frames
+// and prints the final registers and framebuffer to stdout.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "../includes/chip8.h"
+#include "../includes/rom.h"
+#include "../includes/movie.h"
+#include "../includes/analyze.h"
+#include "../includes/audio.h"
+#include "../includes/encode.h"
+
+static void usage()
+{
+    fprintf(stderr,
+            "usage: chip8-run [options] <rom.ch8>\n"
+            "  --cycles N   run N instructions\n"
+            "  --frames N   run N frames of 1/60 s (default 600)\n"
+            "  --clock HZ   instructions per second (default 700)\n"
+            "  --seed N     seed for CXNN random numbers (default 1)\n"
+            "  --blocks     use the block translator\n"
+            "  --precompile analyze the ROM first and decode (with --blocks, translate) the code it finds\n"
+            "  --quirks P   instruction behaviour: default, cosmac-vip, chip-48, super-chip or xo-chip\n"
+            "  --movie FILE replay a recorded movie to its end instead (sets seed, clock, quirks and length)\n"
+            "  --profile P  write a flat profile to P.txt and call stacks to P.folded (chip8-profile only)\n"
+            "  --wav FILE   write the sound to FILE as 16-bit mono WAV\n"
+            "  --rate HZ    sample rate for --wav (default 48000)\n");
+}
+
+// parses a positive integer option value, exits with usage on anything else
+static uint64_t parseCount(const char *option, const char *value)
+{
+    char *end = nullptr;
+    unsigned long long count = value ? strtoull(value, &end, 10) : 0;
+    if (value == nullptr || *value == '\0' || *end != '\0' || count == 0)
+    {
+        fprintf(stderr, "chip8-run: %s needs a positive number\n", option);
+        usage();
+        exit(2);
+    }
+    return count;
+}
+
+static void dumpState(const Chip8 &chip8)
+{
+    printf("PC=0x%03X I=0x%03X SP=%u DT=%u ST=%u cycles=%llu\n", chip8.getPC(), chip8.getIndex(),
+           chip8.getStackPointer(), chip8.getDelayTimer(), chip8.getSoundTimer(),
+           (unsigned long long)chip8.getCycleCount());
+    const std::array<uint8_t, 16> &V = chip8.getRegisters();
+    for (int i = 0; i < 16; i++)
+    {
+        printf("V%X=%02X%c", i, V[i], i == 15 ? '\n' : ' ');
+    }
+    // '#' for a pixel lit on the first plane, '+' on the second, '@' on both
+    const uint64_t *planes[DISPLAY_PLANES] = {chip8.getDisplayPlane(0), chip8.getDisplayPlane(1)};
+    for (int y = 0; y < chip8.getDisplayHeight(); y++)
+    {
+        char line[DISPLAY_MAX_WIDTH + 1];
+        for (int x = 0; x < chip8.getDisplayWidth(); x++)
+        {
+            int word = y * DISPLAY_ROW_WORDS + x / 64;
+            int lit = ((planes[0][word] >> (63 - x % 64)) & 1) | ((planes[1][word] >> (63 - x % 64)) & 1) << 1;
+            line[x] = ".#+@"[lit];
+        }
+        line[chip8.getDisplayWidth()] = '\0';
+        puts(line);
+    }
+}
+
+// what the synth has rendered so far, into the file. Headless runs are far faster than real time,
+// so the run is sliced into frames and drained after each one rather than by a real-time consumer.
+static void drainAudio(AudioSynth &audio, WavWriter &wav)
+{
+    int16_t samples[4096];
+    size_t count;
+    while ((count = audio.read(samples, 4096)) > 0)
+    {
+        wav.write(samples, count);
+    }
+}
+
+// the flat profile as PREFIX.txt and the call stacks as PREFIX.folded, for flamegraph.pl or speedscope
+static bool writeProfile(const Chip8 &chip8, const char *prefix)
+{
+    std::string base = prefix;
+    std::ofstream flat(base + ".txt");
+    flat << chip8.getProfileReport();
+    std::ofstream folded(base + ".folded");
+    folded << chip8.getProfileStacks();
+    if (!flat || !folded)
+    {
+        fprintf(stderr, "chip8-run: cannot write profile to %s.txt and %s.folded\n", prefix, prefix);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint64_t cycles = 0;
+    uint64_t frames = 600;
+    uint32_t clock = 700;
+    uint64_t seed = 1;
+    bool useBlocks = false;
+    bool precompile = false;
+    QuirkProfile quirks = QUIRKS_DEFAULT;
+    const char *romPath = nullptr;
+    const char *moviePath = nullptr;
+    const char *profilePrefix = nullptr;
+    const char *wavPath = nullptr;
+    uint32_t sampleRate = 48000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--cycles") == 0)
+        {
+            cycles = parseCount(arg, value);
+            i++;
+        }
+        else if (strcmp(arg, "--frames") == 0)
+        {
+            frames = parseCount(arg, value);
+            cycles = 0;
+            i++;
+        }
+        else if (strcmp(arg, "--clock") == 0)
+        {
+            clock = parseCount(arg, value);
+            i++;
+        }
+        else if (strcmp(arg, "--seed") == 0)
+        {
+            seed = value ? strtoull(value, nullptr, 10) : 0;
+            i++;
+        }
+        else if (strcmp(arg, "--quirks") == 0)
+        {
+            if (value == nullptr || !parseQuirkProfile(value, quirks))
+            {
+                fprintf(stderr, "chip8-run: --quirks needs one of default, cosmac-vip, chip-48, super-chip, xo-chip\n");
+                return 2;
+            }
+            i++;
+        }
+        else if (strcmp(arg, "--movie") == 0 && value != nullptr)
+        {
+            moviePath = value;
+            i++;
+        }
+        else if (strcmp(arg, "--profile") == 0 && value != nullptr)
+        {
+            if (!CHIP8_PROFILE)
+            {
+                fprintf(stderr, "chip8-run: built without the profiler, use chip8-profile\n");
+                return 2;
+            }
+            profilePrefix = value;
+            i++;
+        }
+        else if (strcmp(arg, "--wav") == 0 && value != nullptr)
+        {
+            wavPath = value;
+            i++;
+        }
+        else if (strcmp(arg, "--rate") == 0)
+        {
+            sampleRate = parseCount(arg, value);
+            i++;
+        }
+        else if (strcmp(arg, "--blocks") == 0)
+        {
+            useBlocks = true;
+        }
+        else if (strcmp(arg, "--precompile") == 0)
+        {
+            precompile = true;
+        }
+        else if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            usage();
+            return 0;
+        }
+        else if (arg[0] == '-' || romPath != nullptr)
+        {
+            fprintf(stderr, "chip8-run: unexpected argument %s\n", arg);
+            usage();
+            return 2;
+        }
+        else
+        {
+            romPath = arg;
+        }
+    }
+    if (romPath == nullptr)
+    {
+        usage();
+        return 2;
+    }
+
+    std::vector<uint8_t> rom;
+    std::string error;
+    if (!readROMFile(romPath, rom, error))
+    {
+        fprintf(stderr, "chip8-run: %s\n", error.c_str());
+        return 1;
+    }
+
+    static Chip8 chip8; // large, keep it off the stack
+    chip8.setBlockTranslation(useBlocks);
+    AudioSynth audio(sampleRate);
+    WavWriter wav;
+    if (wavPath != nullptr && !wav.open(wavPath, sampleRate))
+    {
+        fprintf(stderr, "chip8-run: cannot write %s\n", wavPath);
+        return 1;
+    }
+    if (moviePath != nullptr)
+    {
+        std::ifstream file(moviePath, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        Movie movie;
+        MoviePlayer player;
+        if (!loadMovie(data.data(), data.size(), movie, error) || !player.start(chip8, movie, rom.data(), rom.size()))
+        {
+            fprintf(stderr, "chip8-run: cannot replay %s: %s\n", moviePath,
+                    error.empty() ? "recorded on a different ROM" : error.c_str());
+            return 1;
+        }
+        if (wavPath == nullptr)
+        {
+            player.run(chip8, movie.length);
+        }
+        else
+        {
+            audio.attach(chip8);
+            while (player.run(chip8, std::max<uint32_t>(chip8.getClockSpeed() / 60, 1)) > 0)
+            {
+                audio.update(chip8);
+                drainAudio(audio, wav);
+            }
+        }
+        if (wavPath != nullptr && !wav.close())
+        {
+            fprintf(stderr, "chip8-run: cannot write %s\n", wavPath);
+            return 1;
+        }
+        dumpState(chip8);
+        if (profilePrefix != nullptr && !writeProfile(chip8, profilePrefix))
+        {
+            return 1;
+        }
+        if (movie.displayHash != 0 && movie.displayHash != chip8.getDisplayHash())
+        {
+            fprintf(stderr, "chip8-run: final display differs from the recording\n");
+            return 1;
+        }
+        return 0;
+    }
+    chip8.setClockSpeed(clock);
+    chip8.setQuirks(quirks);
+    chip8.setSeed(seed);
+    chip8.loadROM(rom.data(), rom.size());
+    if (precompile)
+    {
+        std::vector<uint16_t> hints = analyzeROM(rom.data(), rom.size(), quirks).precompileHints();
+        size_t translated = chip8.precompile(hints);
+        // on stderr, so the dump is the same as without --precompile
+        fprintf(stderr, "chip8-run: precompiled %zu code blocks into %zu translated blocks\n", hints.size(), translated);
+    }
+    if (wavPath != nullptr)
+    {
+        audio.attach(chip8);
+    }
+
+    if (cycles == 0)
+    {
+        cycles = frames * clock / 60;
+    }
+    // no keys are ever pressed here, so a key wait just idles out the rest of each batch
+    uint32_t sliceCycles = wavPath != nullptr ? std::max<uint32_t>(clock / 60, 1) : 1000000;
+    while (cycles > 0)
+    {
+        uint32_t batch = cycles > sliceCycles ? sliceCycles : (uint32_t)cycles;
+        chip8.runCycles(batch);
+        cycles -= batch;
+        if (wavPath != nullptr)
+        {
+            audio.update(chip8);
+            drainAudio(audio, wav);
+        }
+    }
+    if (wavPath != nullptr && !wav.close())
+    {
+        fprintf(stderr, "chip8-run: cannot write %s\n", wavPath);
+        return 1;
+    }
+
+    dumpState(chip8);
+    if (profilePrefix != nullptr && !writeProfile(chip8, profilePrefix))
+    {
+        return 1;
+    }
+    return 0;
+}
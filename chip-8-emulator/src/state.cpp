@@ -0,0 +1,297 @@
+#include "../includes/chip8.h"
+#include "../includes/bytes.h"
+#include <cstring>
+
+// saveState layout, version 3, all integers little-endian:
+//   magic "C8ST", u16 version,
+//   machine: u16 PC, u16 I, u8 SP, u8 delay timer, u8 sound timer, u8 waiting for key,
+//            16 x u8 V, 16 x u16 stack, 16 x u8 keys,
+//            u8 quirk profile, u8 high resolution, u8 selected planes, u8 pitch,
+//            16 x u8 RPL flags, 16 x u8 audio pattern,
+//            u32 clock speed, u32 timer phase, u64 cycle count, u32 cycle fraction,
+//            u64 seed, u64 random state,
+//            u8 stored planes (bit n for plane n, the first always), then for each stored plane the
+//            rows the resolution uses: 32 x u64 in low resolution, 64 x 2 x u64 in high
+//   memory, as much as the quirk profile addresses: 4096 bytes, or 65536 for XO-CHIP
+const size_t QUIRKS_OFFSET = 2 + 2 + 1 + 1 + 1 + 1 + 16 + 16 * 2 + 16;
+const size_t PLANES_OFFSET = QUIRKS_OFFSET + 4 + 16 + 16 + 4 + 4 + 8 + 4 + 8 + 8;
+const size_t MACHINE_FIXED_SIZE = PLANES_OFFSET + 1;
+const size_t HEADER_SIZE = sizeof(STATE_MAGIC) + 2;
+
+namespace
+{
+    // display words kept per stored plane
+    size_t planeWords(bool hires)
+    {
+        return hires ? DISPLAY_PLANE_WORDS : DISPLAY_MAX_HEIGHT / 2;
+    }
+
+    // the machine part's size, from its fixed part
+    size_t machineSize(const uint8_t *machine)
+    {
+        int planes = __builtin_popcount(machine[PLANES_OFFSET]);
+        return MACHINE_FIXED_SIZE + planes * planeWords(machine[QUIRKS_OFFSET + 1] != 0) * 8;
+    }
+}
+
+void Chip8::saveMachine(std::vector<uint8_t> &out) const
+{
+    putLE(out, PC, 2);
+    putLE(out, I, 2);
+    putLE(out, SP, 1);
+    putLE(out, delayTimer, 1);
+    putLE(out, soundTimer, 1);
+    putLE(out, waitingForKey, 1);
+    for (uint8_t value : V)
+    {
+        putLE(out, value, 1);
+    }
+    for (uint16_t value : stack)
+    {
+        putLE(out, value, 2);
+    }
+    for (uint8_t value : keys)
+    {
+        putLE(out, value, 1);
+    }
+    putLE(out, quirks, 1);
+    putLE(out, hires, 1);
+    putLE(out, planes, 1);
+    putLE(out, pitch, 1);
+    out.insert(out.end(), flags.begin(), flags.end());
+    out.insert(out.end(), audioPattern.begin(), audioPattern.end());
+    putLE(out, clockSpeed, 4);
+    putLE(out, timerPhase, 4);
+    putLE(out, cycleCount, 8);
+    putLE(out, cycleFraction, 4);
+    putLE(out, seed, 8);
+    putLE(out, rngState, 8);
+    // a low resolution frame is a quarter of the words, and most machines never draw on the second plane
+    uint8_t stored = storedPlanes();
+    putLE(out, stored, 1);
+    int words = hires ? DISPLAY_ROW_WORDS : 1;
+    for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+    {
+        if (!((stored >> plane) & 1))
+        {
+            continue;
+        }
+        const uint64_t *rows = getDisplayPlane(plane);
+        for (int y = 0; y < getDisplayHeight(); y++)
+        {
+            for (int w = 0; w < words; w++)
+            {
+                putLE(out, rows[y * DISPLAY_ROW_WORDS + w], 8);
+            }
+        }
+    }
+}
+
+bool Chip8::loadMachine(const uint8_t *data, size_t size)
+{
+    if (size < MACHINE_FIXED_SIZE || !(data[PLANES_OFFSET] & 1) || data[PLANES_OFFSET] >= 1 << DISPLAY_PLANES ||
+        size != machineSize(data))
+    {
+        return false;
+    }
+    // check the fields the interpreter relies on before touching anything
+    uint8_t savedSP = data[4];
+    uint8_t savedQuirks = data[QUIRKS_OFFSET];
+    uint8_t savedPlanes = data[QUIRKS_OFFSET + 2];
+    ByteReader tail(data + PLANES_OFFSET - 36, 36);
+    uint32_t savedClock = tail.getLE(4);
+    uint32_t savedPhase = tail.getLE(4);
+    tail.data += 8 + 4 + 8; // cycle count, cycle fraction, seed
+    uint64_t savedRandom = tail.getLE(8);
+    if (savedSP > stack.size() || savedClock == 0 || savedPhase >= savedClock || savedRandom == 0 ||
+        savedQuirks >= QUIRK_PROFILE_COUNT || savedPlanes >= 1 << DISPLAY_PLANES)
+    {
+        return false;
+    }
+
+    ByteReader in(data, size);
+    PC = in.getLE(2);
+    I = in.getLE(2);
+    SP = in.getLE(1);
+    delayTimer = in.getLE(1);
+    soundTimer = in.getLE(1);
+    waitingForKey = in.getLE(1) != 0;
+    for (uint8_t &value : V)
+    {
+        value = in.getLE(1);
+    }
+    for (uint16_t &value : stack)
+    {
+        value = in.getLE(2);
+    }
+    for (uint8_t &value : keys)
+    {
+        value = in.getLE(1);
+    }
+    QuirkProfile previousQuirks = quirks;
+    quirks = (QuirkProfile)in.getLE(1);
+    hires = in.getLE(1) != 0;
+    planes = in.getLE(1);
+    pitch = in.getLE(1);
+    for (uint8_t &value : flags)
+    {
+        value = in.getLE(1);
+    }
+    for (uint8_t &value : audioPattern)
+    {
+        value = in.getLE(1);
+    }
+    clockSpeed = in.getLE(4);
+    timerPhase = in.getLE(4);
+    cycleCount = in.getLE(8);
+    cycleFraction = in.getLE(4);
+    seed = in.getLE(8);
+    rngState = in.getLE(8);
+    uint8_t stored = in.getLE(1);
+    display.fill(0); // planes and words not stored were blank
+    int words = hires ? DISPLAY_ROW_WORDS : 1;
+    for (int plane = 0; plane < DISPLAY_PLANES; plane++)
+    {
+        if (!((stored >> plane) & 1))
+        {
+            continue;
+        }
+        uint64_t *rows = planeRows(plane);
+        for (int y = 0; y < getDisplayHeight(); y++)
+        {
+            for (int w = 0; w < words; w++)
+            {
+                rows[y * DISPLAY_ROW_WORDS + w] = in.getLE(8);
+            }
+        }
+    }
+    quirksChanged(previousQuirks); // memory resized for the caller to fill in
+
+    drawn = false;
+    PROFILE_CALLS(); // the restored stack
+    dirtyRows = ~0ULL; // the host has to redraw whatever was restored
+    present();
+    return true;
+}
+
+bool Chip8::replacePage(size_t page, const uint8_t *data)
+{
+    size_t start = page * MEMORY_PAGE_SIZE;
+    if (memcmp(memory.data() + start, data, MEMORY_PAGE_SIZE) == 0)
+    {
+        return false;
+    }
+    memcpy(memory.data() + start, data, MEMORY_PAGE_SIZE);
+    // instructions decoded from the old bytes, including the one straddling the page start
+    if (start < CODE_SIZE)
+    {
+        for (size_t address = start; address < start + MEMORY_PAGE_SIZE; address++)
+        {
+            decodeCache[address].kind = OP_DECODE;
+        }
+        decodeCache[(start - 1) & 0x0FFF].kind = OP_DECODE;
+    }
+    dirtyPages.set(page);
+    return true;
+}
+
+std::vector<uint8_t> Chip8::saveState() const
+{
+    std::vector<uint8_t> out;
+    out.reserve(HEADER_SIZE + MACHINE_FIXED_SIZE + DISPLAY_PLANES * DISPLAY_PLANE_WORDS * 8 + getMemorySize());
+    out.insert(out.end(), STATE_MAGIC, STATE_MAGIC + sizeof(STATE_MAGIC));
+    putLE(out, STATE_VERSION, 2);
+    saveMachine(out);
+    out.insert(out.end(), memory.begin(), memory.begin() + getMemorySize());
+    return out;
+}
+
+bool Chip8::loadState(const uint8_t *data, size_t size)
+{
+    if (size < HEADER_SIZE + MACHINE_FIXED_SIZE || memcmp(data, STATE_MAGIC, sizeof(STATE_MAGIC)) != 0)
+    {
+        TRACE_EVENT("ERROR: not a save state");
+        return false;
+    }
+    uint16_t version = data[4] | (data[5] << 8);
+    if (version != STATE_VERSION)
+    {
+        TRACE_EVENT("ERROR: save state version %u is not supported", version);
+        return false;
+    }
+    // the saved resolution and planes decide how long the machine part is, the profile how much memory follows
+    size_t machine = machineSize(data + HEADER_SIZE);
+    size_t memorySize = quirkMemorySize((QuirkProfile)data[HEADER_SIZE + QUIRKS_OFFSET]);
+    if (size != HEADER_SIZE + machine + memorySize || !loadMachine(data + HEADER_SIZE, machine))
+    {
+        TRACE_EVENT("ERROR: save state is corrupt");
+        return false;
+    }
+    // usually most of memory is unchanged, keep what was decoded and translated from those pages
+    bool changed = false;
+    for (size_t page = 0; page < memorySize / MEMORY_PAGE_SIZE; page++)
+    {
+        changed |= replacePage(page, data + HEADER_SIZE + machine + page * MEMORY_PAGE_SIZE);
+    }
+    if (changed)
+    {
+        blocks.clear();
+    }
+    return true;
+}
+
+Snapshot Chip8::takeSnapshot()
+{
+    Snapshot snapshot;
+    sharedPages.resize(getMemorySize() / MEMORY_PAGE_SIZE);
+    for (size_t page = 0; page < sharedPages.size(); page++)
+    {
+        // pages nobody wrote since the last snapshot are shared with it as they are
+        if (dirtyPages.test(page) || !sharedPages[page])
+        {
+            auto copy = std::make_shared<MemoryPage>();
+            memcpy(copy->data(), memory.data() + page * MEMORY_PAGE_SIZE, MEMORY_PAGE_SIZE);
+            sharedPages[page] = copy;
+        }
+    }
+    dirtyPages.reset();
+    snapshot.pages = sharedPages;
+    snapshot.machine.reserve(MACHINE_FIXED_SIZE + DISPLAY_PLANES * DISPLAY_PLANE_WORDS * 8);
+    saveMachine(snapshot.machine);
+    return snapshot;
+}
+
+void Chip8::restoreSnapshot(const Snapshot &snapshot)
+{
+    for (const auto &page : snapshot.pages)
+    {
+        if (!page)
+        {
+            TRACE_EVENT("ERROR: snapshot is empty");
+            return;
+        }
+    }
+    if (snapshot.machine.size() < MACHINE_FIXED_SIZE ||
+        snapshot.pages.size() != quirkMemorySize((QuirkProfile)snapshot.machine[QUIRKS_OFFSET]) / MEMORY_PAGE_SIZE ||
+        !loadMachine(snapshot.machine.data(), snapshot.machine.size()))
+    {
+        TRACE_EVENT("ERROR: snapshot is corrupt");
+        return;
+    }
+    bool changed = false;
+    for (size_t page = 0; page < snapshot.pages.size(); page++)
+    {
+        // memory still holds this exact page if it is the one we last shared and nobody wrote to it
+        if (!dirtyPages.test(page) && page < sharedPages.size() && sharedPages[page] == snapshot.pages[page])
+        {
+            continue;
+        }
+        changed |= replacePage(page, snapshot.pages[page]->data());
+    }
+    if (changed)
+    {
+        blocks.clear();
+    }
+    sharedPages = snapshot.pages;
+    dirtyPages.reset();
+}
@@ -0,0 +1,54 @@
+#include "../includes/trace.h"
+#include <cstdarg>
+#include <cstdio>
+#include "../includes/host.h"
+
+void TraceBuffer::log(const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vsnprintf(lines[head].data(), LINE_LENGTH, format, args);
+    va_end(args);
+
+    head = (head + 1) % CAPACITY;
+    if (count < CAPACITY)
+    {
+        count++;
+    }
+    else
+    {
+        dropped++; // the oldest line was just overwritten
+    }
+}
+
+const char *TraceBuffer::drain()
+{
+    drained.clear();
+    if (dropped > 0)
+    {
+        drained += "(" + std::to_string(dropped) + " trace lines dropped)\n";
+    }
+    size_t tail = (head + CAPACITY - count) % CAPACITY; // oldest line still held
+    for (size_t i = 0; i < count; i++)
+    {
+        drained += lines[(tail + i) % CAPACITY].data();
+        drained += '\n';
+    }
+    if (!drained.empty())
+    {
+        drained.pop_back(); // no trailing newline
+    }
+    count = 0;
+    dropped = 0;
+    return drained.c_str();
+}
+
+void traceEvent(const char *format, ...)
+{
+    char line[TraceBuffer::LINE_LENGTH];
+    va_list args;
+    va_start(args, format);
+    vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+    hostLog(line);
+}